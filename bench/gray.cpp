@@ -0,0 +1,295 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Microbenchmarks for the scalar operations of gray_code.
+ *
+ * Every operation is measured for every built-in unsigned
+ * integer type in two ways:
+ * - latency: each operation depends on the result of the
+ *   previous one, which measures the length of its critical
+ *   path,
+ * - throughput: the operation is applied to a buffer of
+ *   independent values, which lets the processor overlap
+ *   consecutive operations.
+ *
+ * The benchmark has no dependency beyond the standard library:
+ *
+ *   g++ -std=c++14 -O2 -Iinclude bench/gray.cpp -o bench_gray
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <vector>
+#include <cpp-gray/gray.h>
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Benchmarking utilities
+
+    // Prevents the compiler from optimizing a value away
+    template<typename T>
+    auto do_not_optimize(const T& value)
+        -> void
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile T sink;
+        sink = value;
+#endif
+    }
+
+    constexpr std::size_t buffer_size = 1024;
+    constexpr std::size_t repetitions = 20000;
+
+    // Returns the median time per operation in nanoseconds
+    // over several runs of func, which performs ops operations
+    template<typename Function>
+    auto measure(std::size_t ops, Function func)
+        -> double
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::vector<double> times;
+        for (int run = 0 ; run < 7 ; ++run)
+        {
+            auto start = clock::now();
+            func();
+            auto end = clock::now();
+            std::chrono::duration<double, std::nano> elapsed = end - start;
+            times.push_back(elapsed.count() / static_cast<double>(ops));
+        }
+
+        // Insertion sort is more than enough for seven values
+        for (std::size_t i = 1 ; i < times.size() ; ++i)
+        {
+            for (std::size_t j = i ; j > 0 && times[j] < times[j - 1] ; --j)
+            {
+                auto tmp = times[j];
+                times[j] = times[j - 1];
+                times[j - 1] = tmp;
+            }
+        }
+        return times[times.size() / 2];
+    }
+
+    template<typename Unsigned>
+    auto make_buffer()
+        -> std::vector<Unsigned>
+    {
+        std::vector<Unsigned> res(buffer_size);
+        std::uint64_t state = 0x9e3779b97f4a7c15u;
+        for (auto& value: res)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            value = static_cast<Unsigned>(state);
+        }
+        return res;
+    }
+
+    auto report(const char* type, const char* operation, double latency, double throughput)
+        -> void
+    {
+        std::printf("%-20s %-24s %10.3f %10.3f\n", type, operation, latency, throughput);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Benchmarks
+
+    template<typename Unsigned>
+    auto benchmark(const char* type)
+        -> void
+    {
+        using namespace cppgray;
+        using code_type = gray_code<Unsigned>;
+
+        constexpr std::size_t chain_length = buffer_size * repetitions;
+        const auto values = make_buffer<Unsigned>();
+        std::vector<code_type> codes(buffer_size);
+        for (std::size_t i = 0 ; i < buffer_size ; ++i)
+        {
+            codes[i].value = values[i];
+        }
+
+        // Construction from an unsigned integer
+        {
+            auto latency = measure(chain_length, [&] {
+                Unsigned x = values[0];
+                for (std::size_t i = 0 ; i < chain_length ; ++i)
+                {
+                    x = code_type(x).value;
+                }
+                do_not_optimize(x);
+            });
+            auto throughput = measure(chain_length, [&] {
+                for (std::size_t rep = 0 ; rep < repetitions ; ++rep)
+                {
+                    for (std::size_t i = 0 ; i < buffer_size ; ++i)
+                    {
+                        codes[i] = code_type(values[i]);
+                    }
+                    do_not_optimize(codes.data());
+                }
+            });
+            report(type, "construction", latency, throughput);
+        }
+
+        // Conversion to the underlying type
+        {
+            auto latency = measure(chain_length, [&] {
+                code_type code = codes[0];
+                for (std::size_t i = 0 ; i < chain_length ; ++i)
+                {
+                    code.value = static_cast<Unsigned>(code);
+                }
+                do_not_optimize(code);
+            });
+            std::vector<Unsigned> out(buffer_size);
+            auto throughput = measure(chain_length, [&] {
+                for (std::size_t rep = 0 ; rep < repetitions ; ++rep)
+                {
+                    for (std::size_t i = 0 ; i < buffer_size ; ++i)
+                    {
+                        out[i] = static_cast<Unsigned>(codes[i]);
+                    }
+                    do_not_optimize(out.data());
+                }
+            });
+            report(type, "operator value_type", latency, throughput);
+        }
+
+        // Increment
+        {
+            auto latency = measure(chain_length, [&] {
+                code_type code = codes[0];
+                for (std::size_t i = 0 ; i < chain_length ; ++i)
+                {
+                    ++code;
+                }
+                do_not_optimize(code);
+            });
+            auto throughput = measure(chain_length, [&] {
+                for (std::size_t rep = 0 ; rep < repetitions ; ++rep)
+                {
+                    for (std::size_t i = 0 ; i < buffer_size ; ++i)
+                    {
+                        ++codes[i];
+                    }
+                    do_not_optimize(codes.data());
+                }
+            });
+            report(type, "operator++", latency, throughput);
+        }
+
+        // Decrement
+        {
+            auto latency = measure(chain_length, [&] {
+                code_type code = codes[0];
+                for (std::size_t i = 0 ; i < chain_length ; ++i)
+                {
+                    --code;
+                }
+                do_not_optimize(code);
+            });
+            auto throughput = measure(chain_length, [&] {
+                for (std::size_t rep = 0 ; rep < repetitions ; ++rep)
+                {
+                    for (std::size_t i = 0 ; i < buffer_size ; ++i)
+                    {
+                        --codes[i];
+                    }
+                    do_not_optimize(codes.data());
+                }
+            });
+            report(type, "operator--", latency, throughput);
+        }
+
+        // Mixed comparison with an unsigned integer
+        {
+            auto latency = measure(chain_length, [&] {
+                Unsigned x = values[0];
+                for (std::size_t i = 0 ; i < chain_length ; ++i)
+                {
+                    x = static_cast<Unsigned>(x + (codes[i % buffer_size] == x));
+                }
+                do_not_optimize(x);
+            });
+            auto throughput = measure(chain_length, [&] {
+                for (std::size_t rep = 0 ; rep < repetitions ; ++rep)
+                {
+                    std::size_t count = 0;
+                    for (std::size_t i = 0 ; i < buffer_size ; ++i)
+                    {
+                        count += (codes[i] == values[i]);
+                    }
+                    do_not_optimize(count);
+                }
+            });
+            report(type, "operator==(Unsigned)", latency, throughput);
+        }
+
+        // Parity
+        {
+            auto latency = measure(chain_length, [&] {
+                code_type code = codes[0];
+                for (std::size_t i = 0 ; i < chain_length ; ++i)
+                {
+                    code.value = static_cast<Unsigned>(code.value + is_odd(code));
+                }
+                do_not_optimize(code);
+            });
+            auto throughput = measure(chain_length, [&] {
+                for (std::size_t rep = 0 ; rep < repetitions ; ++rep)
+                {
+                    std::size_t count = 0;
+                    for (std::size_t i = 0 ; i < buffer_size ; ++i)
+                    {
+                        count += is_odd(codes[i]);
+                    }
+                    do_not_optimize(count);
+                }
+            });
+            report(type, "is_odd", latency, throughput);
+        }
+    }
+}
+
+int main()
+{
+    std::printf("%-20s %-24s %10s %10s\n", "type", "operation",
+                "latency", "throughput");
+    std::printf("%-20s %-24s %10s %10s\n", "", "", "(ns/op)", "(ns/op)");
+
+    benchmark<unsigned char>("unsigned char");
+    benchmark<unsigned short>("unsigned short");
+    benchmark<unsigned int>("unsigned int");
+    benchmark<unsigned long>("unsigned long");
+    benchmark<unsigned long long>("unsigned long long");
+}
@@ -0,0 +1,469 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Throughput benchmark for the batch operations of batch.h.
+ *
+ * Every batch operation is run for every lane width on buffers
+ * from a few KiB, which fit in the L1 cache, up to a maximum
+ * size given on the command line in MiB (256 MiB by default),
+ * which shows where the operations become bound by the memory
+ * bandwidth. For every operation and buffer size it reports:
+ * - the bandwidth in GB/s, counting the bytes read and written,
+ * - the number of elements handled per cycle,
+ * - the instructions per cycle and the number of cache misses
+ *   per KiB of input, when the hardware counters are available.
+ *
+ * The cycles, instructions and cache misses are read through
+ * perf_event_open on Linux. When the counters are unavailable
+ * (other systems, perf_event_paranoid, virtual machines), the
+ * cycles fall back to the time-stamp counter on x86 and the
+ * other columns are left empty. Before being measured, every
+ * operation is checked against the scalar gray_code operations,
+ * and the benchmark fails if they disagree.
+ *
+ *   g++ -std=c++14 -O2 -march=native -Iinclude bench/throughput.cpp -o bench_throughput
+ *   ./bench_throughput 4096
+ *
+ * Defining CPPGRAY_RUNTIME_DISPATCH measures the kernels that
+ * are picked at runtime instead of at compile time.
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cpp-gray/batch.h>
+
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#endif
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Hardware counters
+
+    struct counter_values
+    {
+        std::uint64_t cycles = 0;
+        std::uint64_t instructions = 0;
+        std::uint64_t cache_misses = 0;
+        bool has_cycles = false;
+        bool has_counters = false;
+    };
+
+    // Group of perf events read together: cycles, instructions
+    // and last level cache misses
+    class hardware_counters
+    {
+        public:
+
+            hardware_counters()
+            {
+#if defined(__linux__)
+                const std::uint64_t configs[] = {
+                    PERF_COUNT_HW_CPU_CYCLES,
+                    PERF_COUNT_HW_INSTRUCTIONS,
+                    PERF_COUNT_HW_CACHE_MISSES
+                };
+                for (int i = 0 ; i < 3 ; ++i)
+                {
+                    perf_event_attr attr;
+                    std::memset(&attr, 0, sizeof attr);
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.size = sizeof attr;
+                    attr.config = configs[i];
+                    attr.disabled = i == 0;
+                    attr.exclude_kernel = 1;
+                    attr.exclude_hv = 1;
+                    attr.read_format = PERF_FORMAT_GROUP;
+
+                    long fd = syscall(__NR_perf_event_open, &attr, 0, -1,
+                                      i == 0 ? -1 : _fds[0], 0);
+                    if (fd < 0)
+                    {
+                        close_all();
+                        return;
+                    }
+                    _fds[i] = static_cast<int>(fd);
+                }
+#endif
+            }
+
+            hardware_counters(const hardware_counters&) = delete;
+            hardware_counters& operator=(const hardware_counters&) = delete;
+
+            ~hardware_counters()
+            {
+                close_all();
+            }
+
+            auto available() const
+                -> bool
+            {
+                return _fds[0] != -1;
+            }
+
+            auto start()
+                -> void
+            {
+#if defined(__linux__)
+                if (available())
+                {
+                    ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                    ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                    return;
+                }
+#endif
+                _tsc = read_tsc();
+            }
+
+            auto stop()
+                -> counter_values
+            {
+                counter_values res;
+#if defined(__linux__)
+                if (available())
+                {
+                    ioctl(_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+                    std::uint64_t values[4] = {};
+                    if (read(_fds[0], values, sizeof values) == static_cast<ssize_t>(sizeof values))
+                    {
+                        res.cycles = values[1];
+                        res.instructions = values[2];
+                        res.cache_misses = values[3];
+                        res.has_cycles = true;
+                        res.has_counters = true;
+                    }
+                    return res;
+                }
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+                res.cycles = read_tsc() - _tsc;
+                res.has_cycles = true;
+#endif
+                return res;
+            }
+
+        private:
+
+            static auto read_tsc()
+                -> std::uint64_t
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                return __rdtsc();
+#else
+                return 0;
+#endif
+            }
+
+            auto close_all()
+                -> void
+            {
+#if defined(__linux__)
+                for (auto& fd: _fds)
+                {
+                    if (fd != -1)
+                    {
+                        close(fd);
+                        fd = -1;
+                    }
+                }
+#endif
+            }
+
+            int _fds[3] = { -1, -1, -1 };
+            std::uint64_t _tsc = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Benchmarking utilities
+
+    template<typename Unsigned>
+    auto fill(Unsigned* buffer, std::size_t size)
+        -> void
+    {
+        std::uint64_t state = 0x9e3779b97f4a7c15u;
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            buffer[i] = static_cast<Unsigned>(state);
+        }
+    }
+
+    struct measurement
+    {
+        double seconds;
+        counter_values counters;
+    };
+
+    // Runs func enough times to process at least 64 MiB per run,
+    // and keeps the fastest of several runs
+    template<typename Function>
+    auto measure(hardware_counters& counters, std::size_t bytes, Function func)
+        -> measurement
+    {
+        using clock = std::chrono::steady_clock;
+
+        constexpr std::size_t min_bytes = 64u << 20;
+        const std::size_t repetitions = bytes >= min_bytes ? 1 : min_bytes / bytes;
+
+        // Warm up the caches and the page tables
+        func();
+
+        measurement best = { std::numeric_limits<double>::max(), {} };
+        for (int run = 0 ; run < 5 ; ++run)
+        {
+            counters.start();
+            auto start = clock::now();
+            for (std::size_t rep = 0 ; rep < repetitions ; ++rep)
+            {
+                func();
+            }
+            auto end = clock::now();
+            auto values = counters.stop();
+
+            std::chrono::duration<double> elapsed = end - start;
+            double seconds = elapsed.count() / static_cast<double>(repetitions);
+            if (seconds < best.seconds)
+            {
+                auto reps = static_cast<std::uint64_t>(repetitions);
+                values.cycles /= reps;
+                values.instructions /= reps;
+                values.cache_misses /= reps;
+                best = { seconds, values };
+            }
+        }
+        return best;
+    }
+
+    auto report(const char* width, const char* operation, std::size_t bytes,
+                std::size_t elements, std::size_t traffic, const measurement& res)
+        -> void
+    {
+        char size[32];
+        if (bytes >= (1u << 20))
+        {
+            std::snprintf(size, sizeof size, "%zu MiB", bytes >> 20);
+        }
+        else
+        {
+            std::snprintf(size, sizeof size, "%zu KiB", bytes >> 10);
+        }
+
+        std::printf("%-6s %-12s %10s %10.2f", width, operation, size,
+                    static_cast<double>(traffic) / res.seconds / 1e9);
+        if (res.counters.has_cycles && res.counters.cycles)
+        {
+            std::printf(" %12.3f", static_cast<double>(elements) / static_cast<double>(res.counters.cycles));
+        }
+        else
+        {
+            std::printf(" %12s", "-");
+        }
+        if (res.counters.has_counters && res.counters.cycles)
+        {
+            std::printf(" %8.2f %14.2f\n",
+                        static_cast<double>(res.counters.instructions) / static_cast<double>(res.counters.cycles),
+                        static_cast<double>(res.counters.cache_misses) * 1024.0 / static_cast<double>(bytes));
+        }
+        else
+        {
+            std::printf(" %8s %14s\n", "-", "-");
+        }
+    }
+
+    [[noreturn]] auto validation_failure(const char* width, const char* operation, std::size_t index)
+        -> void
+    {
+        std::fprintf(stderr, "%s %s: mismatch with gray_code at index %zu\n",
+                     width, operation, index);
+        std::exit(EXIT_FAILURE);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Validation against the scalar operations
+
+    template<typename Unsigned>
+    auto validate(const char* width)
+        -> void
+    {
+        using namespace cppgray;
+        using code_type = gray_code<Unsigned>;
+
+        // Odd size so that the scalar tails are checked too
+        constexpr std::size_t size = 4096 + 13;
+        std::vector<Unsigned> values(size);
+        fill(values.data(), size);
+        values[0] = 0;
+        values[1] = std::numeric_limits<Unsigned>::max();
+
+        std::vector<code_type> codes(size);
+        encode(values.data(), codes.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            if (codes[i] != code_type(values[i]))
+            {
+                validation_failure(width, "encode", i);
+            }
+        }
+
+        std::vector<Unsigned> decoded(size);
+        decode(codes.data(), decoded.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            if (decoded[i] != static_cast<Unsigned>(codes[i]))
+            {
+                validation_failure(width, "decode", i);
+            }
+        }
+
+        std::unique_ptr<bool[]> odd(new bool[size]);
+        is_odd(codes.data(), odd.get(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            if (odd[i] != is_odd(codes[i]))
+            {
+                validation_failure(width, "is_odd", i);
+            }
+        }
+
+        auto next = codes;
+        increment(next.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            if (next[i] != successor(codes[i]))
+            {
+                validation_failure(width, "increment", i);
+            }
+        }
+
+        generate_gray(values[2], size, next.data());
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            if (next[i] != code_type(static_cast<Unsigned>(values[2] + i)))
+            {
+                validation_failure(width, "generate_gray", i);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Benchmarks
+
+    template<typename Unsigned>
+    auto benchmark(const char* width, std::size_t max_bytes, hardware_counters& counters)
+        -> void
+    {
+        using namespace cppgray;
+        using code_type = gray_code<Unsigned>;
+
+        validate<Unsigned>(width);
+
+        const std::size_t max_size = max_bytes / sizeof(Unsigned);
+        std::unique_ptr<Unsigned[]> values(new Unsigned[max_size]);
+        std::unique_ptr<code_type[]> codes(new code_type[max_size]);
+        std::unique_ptr<bool[]> parities(new bool[max_size]);
+        fill(values.get(), max_size);
+        encode(values.get(), codes.get(), max_size);
+
+        for (std::size_t bytes = 16u << 10 ; bytes <= max_bytes ; bytes *= 4)
+        {
+            const std::size_t size = bytes / sizeof(Unsigned);
+
+            auto res = measure(counters, bytes, [&] {
+                encode(values.get(), codes.get(), size);
+            });
+            report(width, "encode", bytes, size, 2 * bytes, res);
+
+            res = measure(counters, bytes, [&] {
+                decode(codes.get(), values.get(), size);
+            });
+            report(width, "decode", bytes, size, 2 * bytes, res);
+
+            res = measure(counters, bytes, [&] {
+                is_odd(codes.get(), parities.get(), size);
+            });
+            report(width, "is_odd", bytes, size, bytes + size * sizeof(bool), res);
+
+            res = measure(counters, bytes, [&] {
+                increment(codes.get(), size);
+            });
+            report(width, "increment", bytes, size, 2 * bytes, res);
+
+            res = measure(counters, bytes, [&] {
+                generate_gray(values[0], size, codes.get());
+            });
+            report(width, "generate", bytes, size, bytes, res);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t max_mib = 256;
+    if (argc > 1)
+    {
+        max_mib = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+        if (max_mib == 0)
+        {
+            std::fprintf(stderr, "usage: %s [max buffer size in MiB]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    const std::size_t max_bytes = max_mib << 20;
+
+    hardware_counters counters;
+    if (not counters.available())
+    {
+        std::printf("hardware counters unavailable, cycles %s\n\n",
+#if defined(__x86_64__) || defined(__i386__)
+                    "measured with the time-stamp counter"
+#else
+                    "not measured"
+#endif
+                    );
+    }
+
+    std::printf("%-6s %-12s %10s %10s %12s %8s %14s\n", "width", "operation",
+                "buffer", "GB/s", "elements/cyc", "IPC", "misses/KiB");
+
+    benchmark<std::uint8_t>("8", max_bytes, counters);
+    benchmark<std::uint16_t>("16", max_bytes, counters);
+    benchmark<std::uint32_t>("32", max_bytes, counters);
+    benchmark<std::uint64_t>("64", max_bytes, counters);
+}
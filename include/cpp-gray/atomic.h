@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_ATOMIC_H_
+#define CPPGRAY_ATOMIC_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include "gray.h"
+
+namespace cppgray
+{
+    /**
+     * @brief Gray code that can be shared between threads.
+     *
+     * Incrementing a Gray code flips a single bit, so a reader
+     * of the shared value only ever observes a Gray code or its
+     * successor, even when it samples the bits asynchronously,
+     * while a binary counter changes several bits on carries.
+     * Every operation is lock-free whenever std::atomic<Unsigned>
+     * is, in which case the counter can also live in memory
+     * shared between processes.
+     *
+     * Several threads can increment the counter concurrently
+     * with increment() and decrement(), which use a compare and
+     * swap loop. When a single thread ever writes to the counter,
+     * single_writer_increment() flips the bit with one fetch_xor
+     * instead.
+     *
+     * atomic_gray_code<std::uint32_t> counter;
+     * counter.increment();
+     * counter.load_value();  // 1
+     */
+    template<typename Unsigned, std::size_t Bits = std::numeric_limits<Unsigned>::digits>
+    class atomic_gray_code
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using value_type = gray_code<Unsigned, Bits>;
+            using integer_type = Unsigned;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            atomic_gray_code() noexcept;
+            explicit atomic_gray_code(value_type code) noexcept;
+
+            atomic_gray_code(const atomic_gray_code&) = delete;
+            atomic_gray_code& operator=(const atomic_gray_code&) = delete;
+
+            auto is_lock_free() const noexcept
+                -> bool;
+
+            ////////////////////////////////////////////////////////////
+            // Loads and stores
+
+            auto load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+                -> value_type;
+
+            /**
+             * @brief Loads the Gray code and decodes it.
+             */
+            auto load_value(std::memory_order order = std::memory_order_seq_cst) const noexcept
+                -> integer_type;
+
+            auto store(value_type code, std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> void;
+
+            ////////////////////////////////////////////////////////////
+            // Increment/decrement operations
+
+            /**
+             * @brief Atomically increments the Gray code.
+             *
+             * @return Gray code after the increment
+             */
+            auto increment(std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> value_type;
+
+            /**
+             * @brief Atomically decrements the Gray code.
+             *
+             * @return Gray code after the decrement
+             */
+            auto decrement(std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> value_type;
+
+            /**
+             * @brief Increments the Gray code with a single fetch_xor.
+             *
+             * Only valid when the calling thread is the only one to
+             * ever modify the counter: the bit to flip is computed
+             * from a relaxed load of the current value.
+             *
+             * @return Gray code after the increment
+             */
+            auto single_writer_increment(std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> value_type;
+
+        private:
+
+            std::atomic<Unsigned> _value;
+    };
+
+    #include "atomic.inl"
+}
+
+#endif // CPPGRAY_ATOMIC_H_
@@ -0,0 +1,116 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Construction
+
+template<typename Unsigned, std::size_t Bits>
+atomic_gray_code<Unsigned, Bits>::atomic_gray_code() noexcept:
+    _value(0)
+{}
+
+template<typename Unsigned, std::size_t Bits>
+atomic_gray_code<Unsigned, Bits>::atomic_gray_code(value_type code) noexcept:
+    _value(code.value)
+{}
+
+template<typename Unsigned, std::size_t Bits>
+auto atomic_gray_code<Unsigned, Bits>::is_lock_free() const noexcept
+    -> bool
+{
+    return _value.is_lock_free();
+}
+
+////////////////////////////////////////////////////////////
+// Loads and stores
+
+template<typename Unsigned, std::size_t Bits>
+auto atomic_gray_code<Unsigned, Bits>::load(std::memory_order order) const noexcept
+    -> value_type
+{
+    value_type res;
+    res.value = _value.load(order);
+    return res;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto atomic_gray_code<Unsigned, Bits>::load_value(std::memory_order order) const noexcept
+    -> integer_type
+{
+    return static_cast<integer_type>(load(order));
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto atomic_gray_code<Unsigned, Bits>::store(value_type code, std::memory_order order) noexcept
+    -> void
+{
+    _value.store(code.value, order);
+}
+
+////////////////////////////////////////////////////////////
+// Increment/decrement operations
+
+template<typename Unsigned, std::size_t Bits>
+auto atomic_gray_code<Unsigned, Bits>::increment(std::memory_order order) noexcept
+    -> value_type
+{
+    Unsigned expected = _value.load(std::memory_order_relaxed);
+    value_type code;
+    do
+    {
+        // On failure, expected is updated to the current value
+        code.value = expected;
+        ++code;
+    } while (not _value.compare_exchange_weak(expected, code.value,
+                                              order, std::memory_order_relaxed));
+    return code;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto atomic_gray_code<Unsigned, Bits>::decrement(std::memory_order order) noexcept
+    -> value_type
+{
+    Unsigned expected = _value.load(std::memory_order_relaxed);
+    value_type code;
+    do
+    {
+        // On failure, expected is updated to the current value
+        code.value = expected;
+        --code;
+    } while (not _value.compare_exchange_weak(expected, code.value,
+                                              order, std::memory_order_relaxed));
+    return code;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto atomic_gray_code<Unsigned, Bits>::single_writer_increment(std::memory_order order) noexcept
+    -> value_type
+{
+    value_type code;
+    code.value = _value.load(std::memory_order_relaxed);
+    const Unsigned previous = code.value;
+    ++code;
+    _value.fetch_xor(static_cast<Unsigned>(previous ^ code.value), order);
+    return code;
+}
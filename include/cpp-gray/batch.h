@@ -0,0 +1,294 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_BATCH_H_
+#define CPPGRAY_BATCH_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#if defined(CPPGRAY_USE_EXECUTION_POLICIES) && __cplusplus >= 201703L
+#   include <algorithm>
+#   include <execution>
+#   include <utility>
+#   include <vector>
+#endif
+#include "gray.h"
+#include "detail/dispatch.h"
+#include "detail/simd.h"
+
+namespace cppgray
+{
+    /*
+     * Batch operations work on contiguous buffers and
+     * are mostly meant to convert large amounts of data
+     * at once. Every element is converted independently,
+     * which allows to use the widest SIMD instruction set
+     * available at compile time (SSE2, AVX2, AVX-512 or
+     * NEON). The elements that don't fill a full vector
+     * are handled with the scalar gray_code operations.
+     *
+     * The input and output buffers may be the same buffer,
+     * in which case the conversion happens in place, but
+     * they shall not partially overlap.
+     *
+     * When the macro CPPGRAY_RUNTIME_DISPATCH is defined, the
+     * SIMD instruction set is instead picked at runtime on
+     * x86-64, among SSE2, AVX2 and AVX-512: a binary built for
+     * the x86-64 baseline then uses the widest vectors of the
+     * machine it runs on. The CPU is only checked the first
+     * time each operation is called.
+     */
+
+    ////////////////////////////////////////////////////////////
+    // Conversion operations
+
+    /**
+     * @brief Converts unsigned integers to Gray codes.
+     *
+     * Equivalent to calling the gray_code constructor
+     * on every element of the input buffer.
+     *
+     * @param in Unsigned integers to convert
+     * @param out Resulting Gray codes
+     * @param size Number of elements to convert
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto encode(const Unsigned* in, gray_code<Unsigned, Bits>* out, std::size_t size) noexcept
+        -> void;
+
+    /**
+     * @brief Converts Gray codes to unsigned integers.
+     *
+     * Equivalent to calling the conversion operator to
+     * the underlying type on every element of the input
+     * buffer.
+     *
+     * @param in Gray codes to convert
+     * @param out Resulting unsigned integers
+     * @param size Number of elements to convert
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto decode(const gray_code<Unsigned, Bits>* in, Unsigned* out, std::size_t size) noexcept
+        -> void;
+
+#if defined(CPPGRAY_USE_EXECUTION_POLICIES) && defined(__cpp_lib_execution)
+    ////////////////////////////////////////////////////////////
+    // Parallel conversion operations
+    //
+    // The buffers are split into chunks of a few hundred
+    // kilobytes which are converted with the functions above
+    // as independent tasks, following the given standard
+    // execution policy. Unlike the sequential functions they
+    // may allocate memory, hence throw std::bad_alloc.
+    //
+    // These overloads are only available when the macro
+    // CPPGRAY_USE_EXECUTION_POLICIES is defined before the
+    // header is included: <execution> may need a parallel
+    // backend such as TBB to be linked in, even when the
+    // parallel algorithms are not used.
+
+    /**
+     * @brief Converts unsigned integers to Gray codes in parallel.
+     *
+     * @param policy Standard execution policy
+     * @param in Unsigned integers to convert
+     * @param out Resulting Gray codes
+     * @param size Number of elements to convert
+     */
+    template<typename ExecutionPolicy, typename Unsigned, std::size_t Bits>
+    auto encode(ExecutionPolicy&& policy, const Unsigned* in,
+                gray_code<Unsigned, Bits>* out, std::size_t size)
+        -> std::enable_if_t<std::is_execution_policy<std::decay_t<ExecutionPolicy>>::value>;
+
+    /**
+     * @brief Converts Gray codes to unsigned integers in parallel.
+     *
+     * @param policy Standard execution policy
+     * @param in Gray codes to convert
+     * @param out Resulting unsigned integers
+     * @param size Number of elements to convert
+     */
+    template<typename ExecutionPolicy, typename Unsigned, std::size_t Bits>
+    auto decode(ExecutionPolicy&& policy, const gray_code<Unsigned, Bits>* in,
+                Unsigned* out, std::size_t size)
+        -> std::enable_if_t<std::is_execution_policy<std::decay_t<ExecutionPolicy>>::value>;
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Increment/decrement operations
+
+    /**
+     * @brief Increments every Gray code of a buffer.
+     *
+     * Equivalent to calling operator++ on every element of
+     * the buffer. The Gray codes are independent counters:
+     * the bit to flip is computed for every lane without any
+     * branch, so the cost doesn't depend on the values.
+     *
+     * @param codes Gray codes to increment
+     * @param size Number of elements to increment
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto increment(gray_code<Unsigned, Bits>* codes, std::size_t size) noexcept
+        -> void;
+
+    /**
+     * @brief Decrements every Gray code of a buffer.
+     *
+     * Equivalent to calling operator-- on every element of
+     * the buffer.
+     *
+     * @param codes Gray codes to decrement
+     * @param size Number of elements to decrement
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto decrement(gray_code<Unsigned, Bits>* codes, std::size_t size) noexcept
+        -> void;
+
+    ////////////////////////////////////////////////////////////
+    // Generation operations
+
+    /**
+     * @brief Writes the Gray codes of consecutive positions.
+     *
+     * Writes the Gray codes of the positions [start, start + size)
+     * of the Gray sequence, with the modular semantics of the Gray
+     * codes: equivalent to constructing every Gray code from its
+     * position, or to incrementing a Gray code size - 1 times. The
+     * positions are generated in vectors, without any dependency
+     * between consecutive Gray codes.
+     *
+     * @param start Position of the first Gray code
+     * @param size Number of Gray codes to write
+     * @param out Consecutive Gray codes of the sequence
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto generate_gray(Unsigned start, std::size_t size, gray_code<Unsigned, Bits>* out) noexcept
+        -> void;
+
+    /**
+     * @brief Writes the indices of the bits flipped between
+     *        consecutive Gray codes.
+     *
+     * out[i] is the index of the bit flipped to go from the Gray
+     * code at position start + i to the next one, that is the
+     * number of trailing zeros of start + i + 1, also known as
+     * the ruler sequence. The Gray code at the greatest position
+     * of Unsigned is followed by 0 by flipping its most significant
+     * bit. Starting from 0, the first 2^bits - 1 indices are the
+     * flips given by for_each_gray_flip.
+     *
+     * @param start Position of the first Gray code
+     * @param size Number of indices to write
+     * @param out Indices of the flipped bits
+     */
+    template<typename Unsigned>
+    auto generate_flips(Unsigned start, std::size_t size, std::uint8_t* out) noexcept
+        -> void;
+
+    ////////////////////////////////////////////////////////////
+    // Mathematical functions
+
+    /**
+     * @brief Checks whether Gray codes are odd.
+     *
+     * Equivalent to calling is_odd on every element of the
+     * input buffer. The parity is computed with a vector
+     * population count when AVX-512 VPOPCNTDQ (32-bit and
+     * 64-bit lanes) or BITALG (8-bit and 16-bit lanes) is
+     * available, and by folding the bits of every lane
+     * otherwise.
+     *
+     * @param in Gray codes to check
+     * @param out Whether the corresponding Gray codes are odd
+     * @param size Number of elements to check
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto is_odd(const gray_code<Unsigned, Bits>* in, bool* out, std::size_t size) noexcept
+        -> void;
+
+    /**
+     * @brief Checks whether Gray codes are even.
+     *
+     * Equivalent to calling is_even on every element of the
+     * input buffer.
+     *
+     * @param in Gray codes to check
+     * @param out Whether the corresponding Gray codes are even
+     * @param size Number of elements to check
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto is_even(const gray_code<Unsigned, Bits>* in, bool* out, std::size_t size) noexcept
+        -> void;
+
+    ////////////////////////////////////////////////////////////
+    // Neighbourhood functions
+
+    /**
+     * @brief Hamming distances between a Gray code and the Gray
+     *        codes of a buffer.
+     *
+     * Equivalent to calling hamming_distance with the query and
+     * every element of the input buffer. The population counts
+     * use the same instructions as is_odd.
+     *
+     * @param query Gray code to compare the buffer to
+     * @param codes Gray codes to compare to the query
+     * @param out Number of bits that differ from the query
+     * @param size Number of elements to compare
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto hamming_distance(gray_code<Unsigned, Bits> query, const gray_code<Unsigned, Bits>* codes,
+                          std::uint8_t* out, std::size_t size) noexcept
+        -> void;
+
+    /**
+     * @brief Finds the Gray codes of a buffer close to a given one.
+     *
+     * Writes the indices of the Gray codes whose Hamming distance
+     * to the query is at most radius, in increasing order. The
+     * comparisons are vectorized, and the indices are extracted
+     * from the resulting bitmasks.
+     *
+     * @param query Gray code to compare the buffer to
+     * @param radius Greatest Hamming distance to the query
+     * @param codes Gray codes to compare to the query
+     * @param size Number of elements to compare
+     * @param out Indices of the matching Gray codes, up to size of them
+     * @return Number of indices written to out
+     */
+    template<typename Unsigned, std::size_t Bits>
+    auto find_within(gray_code<Unsigned, Bits> query, std::size_t radius,
+                     const gray_code<Unsigned, Bits>* codes, std::size_t size,
+                     std::size_t* out) noexcept
+        -> std::size_t;
+
+    #include "batch.inl"
+}
+
+#endif // CPPGRAY_BATCH_H_
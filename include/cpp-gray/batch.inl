@@ -0,0 +1,788 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // SIMD kernels
+    //
+    // Every kernel returns the number of elements it handled,
+    // the remaining ones are left to the scalar code
+
+#if defined(CPPGRAY_SIMD_DISPATCH) && not defined(__clang__)
+    // With runtime dispatch, the kernels are instantiated for
+    // instruction sets that the default target lacks, and GCC
+    // warns about the vector arguments of the ops. These kernels
+    // are only ever inlined in functions compiled for the right
+    // target, where the warning doesn't apply
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+    template<std::size_t Bits, typename Unsigned>
+    auto encode_kernel(no_simd_ops, const Unsigned*, Unsigned*, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+    template<std::size_t Bits, typename Ops, typename Unsigned>
+    auto encode_kernel(Ops, const Unsigned* in, Unsigned* out, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+        const auto mask = Ops::template broadcast<Unsigned>(gray_code<Unsigned, Bits>::mask);
+
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            auto v = Ops::load(in + i);
+            if (Bits < std::numeric_limits<Unsigned>::digits)
+            {
+                v = Ops::bit_and(v, mask);
+            }
+            v = Ops::bit_xor(v, Ops::template shift_right<Unsigned>(v, 1));
+            Ops::store(out + i, v);
+        }
+        return i;
+    }
+
+    template<std::size_t Bits, typename Unsigned>
+    auto decode_kernel(no_simd_ops, const Unsigned*, Unsigned*, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+    template<std::size_t Bits, typename Ops, typename Unsigned>
+    auto decode_kernel(Ops, const Unsigned* in, Unsigned* out, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            auto v = Ops::load(in + i);
+            for (int shift = static_cast<int>(decode_shift(Bits)) ; shift ; shift >>= 1)
+            {
+                v = Ops::bit_xor(v, Ops::template shift_right<Unsigned>(v, shift));
+            }
+            Ops::store(out + i, v);
+        }
+        return i;
+    }
+
+    // Parity of every lane, as a bitmask; the vector is taken by
+    // reference for the instantiations used by runtime dispatch,
+    // which can't pass it in a register of the default target
+    template<typename Unsigned, typename Ops>
+    auto lane_parity(Ops, const typename Ops::vector& lanes) noexcept
+        -> std::uint64_t
+    {
+        // Fold every lane with left shifts so that its most
+        // significant bit ends up holding the parity
+        auto v = lanes;
+        for (int shift = std::numeric_limits<Unsigned>::digits / 2
+             ; shift ; shift >>= 1)
+        {
+            v = Ops::bit_xor(v, Ops::template shift_left<Unsigned>(v, shift));
+        }
+        return Ops::template msb_mask<Unsigned>(v);
+    }
+
+#if defined(CPPGRAY_SIMD_AVX512VPOPCNTDQ)
+    inline auto popcount_parity(__m512i v, lane_width<4>) noexcept
+        -> std::uint64_t
+    {
+        return _mm512_test_epi32_mask(_mm512_popcnt_epi32(v), _mm512_set1_epi32(1));
+    }
+
+    inline auto popcount_parity(__m512i v, lane_width<8>) noexcept
+        -> std::uint64_t
+    {
+        return _mm512_test_epi64_mask(_mm512_popcnt_epi64(v), _mm512_set1_epi64(1));
+    }
+
+#   if defined(CPPGRAY_SIMD_AVX512BITALG)
+    inline auto popcount_parity(__m512i v, lane_width<1>) noexcept
+        -> std::uint64_t
+    {
+        return _mm512_test_epi8_mask(_mm512_popcnt_epi8(v), _mm512_set1_epi8(1));
+    }
+
+    inline auto popcount_parity(__m512i v, lane_width<2>) noexcept
+        -> std::uint64_t
+    {
+        return _mm512_test_epi16_mask(_mm512_popcnt_epi16(v), _mm512_set1_epi16(1));
+    }
+#   endif
+
+    // Use the vector population count when it exists for the lane width
+    template<typename Unsigned>
+    auto lane_parity(avx512_ops, __m512i v) noexcept
+        -> decltype(popcount_parity(v, lane_width<sizeof(Unsigned)>{}))
+    {
+        return popcount_parity(v, lane_width<sizeof(Unsigned)>{});
+    }
+#endif
+
+    template<typename Unsigned>
+    auto parity_kernel(no_simd_ops, const Unsigned*, bool*, bool, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+#if defined(CPPGRAY_SIMD_NEON)
+    // NEON has no cheap way to extract a bitmask from a vector
+    template<typename Unsigned>
+    auto parity_kernel(neon_ops, const Unsigned*, bool*, bool, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+#endif
+
+    template<typename Ops, typename Unsigned>
+    auto parity_kernel(Ops, const Unsigned* in, bool* out, bool odd, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+        const std::uint64_t flip = odd ? 0u : 1u;
+
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            auto mask = lane_parity<Unsigned>(Ops{}, Ops::load(in + i));
+            for (std::size_t lane = 0 ; lane < lanes ; ++lane)
+            {
+                out[i + lane] = static_cast<bool>(((mask >> lane) & 1u) ^ flip);
+            }
+        }
+        return i;
+    }
+
+    template<std::size_t Bits, typename Unsigned>
+    auto step_kernel(no_simd_ops, Unsigned*, bool, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+    // Increments or decrements every lane with the branchless
+    // algorithm of successor_flip and predecessor_flip
+    template<std::size_t Bits, typename Ops, typename Unsigned>
+    auto step_kernel(Ops, Unsigned* codes, bool forward, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+        constexpr Unsigned msb = Unsigned(1) << (Bits - 1);
+        const auto zero = Ops::template broadcast<Unsigned>(0);
+        const auto one = Ops::template broadcast<Unsigned>(1);
+        const auto top = Ops::template broadcast<Unsigned>(msb);
+        const auto mask = Ops::template broadcast<Unsigned>(gray_code<Unsigned, Bits>::mask);
+
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            auto v = Ops::load(codes + i);
+
+            // The lowest bit of the decoded lanes is their parity,
+            // which is then spread to the whole lanes
+            auto parity = v;
+            for (int shift = static_cast<int>(decode_shift(Bits)) ; shift ; shift >>= 1)
+            {
+                parity = Ops::bit_xor(parity, Ops::template shift_right<Unsigned>(parity, shift));
+            }
+            auto odd = Ops::template sub<Unsigned>(zero, Ops::bit_and(parity, one));
+
+            // Bit on the left of the lowest set bit, the msb
+            // standing in for the bit beyond the most significant
+            // one, which also handles the wraparound
+            auto low = Ops::bit_or(v, top);
+            auto y = Ops::bit_and(low, Ops::template sub<Unsigned>(zero, low));
+            auto up = Ops::bit_or(Ops::bit_and(Ops::template shift_left<Unsigned>(y, 1), mask),
+                                  Ops::bit_and(y, top));
+
+            auto flip = Ops::bit_xor(forward ? one : up,
+                                     Ops::bit_and(Ops::bit_xor(up, one), odd));
+            Ops::store(codes + i, Ops::bit_xor(v, flip));
+        }
+        return i;
+    }
+
+    // Population count of every lane, written to res; as with
+    // lane_parity, the vectors are passed by reference
+    template<typename Unsigned, typename Ops>
+    auto lane_popcount(Ops, const typename Ops::vector& lanes, typename Ops::vector& res) noexcept
+        -> void
+    {
+        const auto ones = Ops::template broadcast<Unsigned>(static_cast<Unsigned>(0x5555555555555555u));
+        const auto pairs = Ops::template broadcast<Unsigned>(static_cast<Unsigned>(0x3333333333333333u));
+        const auto nibbles = Ops::template broadcast<Unsigned>(static_cast<Unsigned>(0x0f0f0f0f0f0f0f0fu));
+
+        // Count the bits of every pair, nibble then byte, then
+        // add the bytes of every lane into its lowest byte
+        auto v = Ops::template sub<Unsigned>(lanes, Ops::bit_and(Ops::template shift_right<Unsigned>(lanes, 1), ones));
+        v = Ops::template add<Unsigned>(Ops::bit_and(v, pairs),
+                                        Ops::bit_and(Ops::template shift_right<Unsigned>(v, 2), pairs));
+        v = Ops::bit_and(Ops::template add<Unsigned>(v, Ops::template shift_right<Unsigned>(v, 4)), nibbles);
+        for (int shift = 8 ; shift < std::numeric_limits<Unsigned>::digits ; shift <<= 1)
+        {
+            v = Ops::template add<Unsigned>(v, Ops::template shift_right<Unsigned>(v, shift));
+        }
+        res = Ops::bit_and(v, Ops::template broadcast<Unsigned>(0x7f));
+    }
+
+#if defined(CPPGRAY_SIMD_AVX512VPOPCNTDQ)
+    inline auto popcount_lanes(const __m512i& v, __m512i& res, lane_width<4>) noexcept
+        -> void
+    {
+        res = _mm512_popcnt_epi32(v);
+    }
+
+    inline auto popcount_lanes(const __m512i& v, __m512i& res, lane_width<8>) noexcept
+        -> void
+    {
+        res = _mm512_popcnt_epi64(v);
+    }
+
+#   if defined(CPPGRAY_SIMD_AVX512BITALG)
+    inline auto popcount_lanes(const __m512i& v, __m512i& res, lane_width<1>) noexcept
+        -> void
+    {
+        res = _mm512_popcnt_epi8(v);
+    }
+
+    inline auto popcount_lanes(const __m512i& v, __m512i& res, lane_width<2>) noexcept
+        -> void
+    {
+        res = _mm512_popcnt_epi16(v);
+    }
+#   endif
+
+    template<typename Unsigned>
+    auto lane_popcount(avx512_ops, const __m512i& v, __m512i& res) noexcept
+        -> decltype(popcount_lanes(v, res, lane_width<sizeof(Unsigned)>{}))
+    {
+        popcount_lanes(v, res, lane_width<sizeof(Unsigned)>{});
+    }
+#endif
+
+    // Stores the lanes of a vector narrowed to bytes; the lanes
+    // are expected to hold values that fit in a byte
+    template<typename Unsigned, typename Ops>
+    auto store_bytes(Ops, const typename Ops::vector& v, std::uint8_t* out) noexcept
+        -> void
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+
+        if (sizeof(Unsigned) == 1)
+        {
+            Ops::store(out, v);
+        }
+        else
+        {
+            Unsigned values[lanes];
+            Ops::store(values, v);
+            for (std::size_t lane = 0 ; lane < lanes ; ++lane)
+            {
+                out[lane] = static_cast<std::uint8_t>(values[lane]);
+            }
+        }
+    }
+
+    template<typename Unsigned>
+    auto distance_kernel(no_simd_ops, Unsigned, const Unsigned*, std::uint8_t*, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+    template<typename Ops, typename Unsigned>
+    auto distance_kernel(Ops, Unsigned query, const Unsigned* in,
+                         std::uint8_t* out, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+        const auto q = Ops::template broadcast<Unsigned>(query);
+
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            auto v = Ops::bit_xor(Ops::load(in + i), q);
+            lane_popcount<Unsigned>(Ops{}, v, v);
+            store_bytes<Unsigned>(Ops{}, v, out + i);
+        }
+        return i;
+    }
+
+    template<typename Unsigned>
+    auto within_kernel(no_simd_ops, Unsigned, Unsigned, const Unsigned*,
+                       std::size_t*, std::size_t*, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+#if defined(CPPGRAY_SIMD_NEON)
+    // NEON has no cheap way to extract a bitmask from a vector
+    template<typename Unsigned>
+    auto within_kernel(neon_ops, Unsigned, Unsigned, const Unsigned*,
+                       std::size_t*, std::size_t*, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+#endif
+
+    template<typename Ops, typename Unsigned>
+    auto within_kernel(Ops, Unsigned query, Unsigned radius, const Unsigned* in,
+                       std::size_t* out, std::size_t* found, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+        constexpr std::uint64_t all_lanes = lanes == 64 ? ~std::uint64_t(0)
+                                                        : (std::uint64_t(1) << lanes % 64) - 1u;
+        const auto q = Ops::template broadcast<Unsigned>(query);
+        const auto r = Ops::template broadcast<Unsigned>(radius);
+
+        std::size_t count = *found;
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            // The counts and the radius are small enough for the
+            // sign bit of their difference to tell which is larger
+            auto v = Ops::bit_xor(Ops::load(in + i), q);
+            lane_popcount<Unsigned>(Ops{}, v, v);
+            auto far = Ops::template msb_mask<Unsigned>(Ops::template sub<Unsigned>(r, v));
+            for (auto matches = ~far & all_lanes ; matches ; matches &= matches - 1u)
+            {
+                out[count++] = i + static_cast<std::size_t>(countr_zero(matches));
+            }
+        }
+        *found = count;
+        return i;
+    }
+
+    template<std::size_t Bits, typename Unsigned>
+    auto generate_kernel(no_simd_ops, Unsigned, Unsigned*, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+    // Encodes a vector of consecutive positions, which is then
+    // moved forward by the number of lanes
+    template<std::size_t Bits, typename Ops, typename Unsigned>
+    auto generate_kernel(Ops, Unsigned start, Unsigned* out, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+        const auto step = Ops::template broadcast<Unsigned>(static_cast<Unsigned>(lanes));
+        const auto mask = Ops::template broadcast<Unsigned>(gray_code<Unsigned, Bits>::mask);
+
+        Unsigned iota[lanes];
+        for (std::size_t lane = 0 ; lane < lanes ; ++lane)
+        {
+            iota[lane] = static_cast<Unsigned>(start + lane);
+        }
+        auto positions = Ops::load(iota);
+
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            auto v = positions;
+            if (Bits < std::numeric_limits<Unsigned>::digits)
+            {
+                v = Ops::bit_and(v, mask);
+            }
+            v = Ops::bit_xor(v, Ops::template shift_right<Unsigned>(v, 1));
+            Ops::store(out + i, v);
+            positions = Ops::template add<Unsigned>(positions, step);
+        }
+        return i;
+    }
+
+    template<typename Unsigned>
+    auto flips_kernel(no_simd_ops, Unsigned, std::uint8_t*, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+    // Counts the trailing zeros of consecutive positions as the
+    // population count of the bits below their lowest set bit
+    template<typename Ops, typename Unsigned>
+    auto flips_kernel(Ops, Unsigned start, std::uint8_t* out, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+        constexpr Unsigned msb = Unsigned(1) << (std::numeric_limits<Unsigned>::digits - 1);
+        const auto zero = Ops::template broadcast<Unsigned>(0);
+        const auto one = Ops::template broadcast<Unsigned>(1);
+        const auto top = Ops::template broadcast<Unsigned>(msb);
+        const auto step = Ops::template broadcast<Unsigned>(static_cast<Unsigned>(lanes));
+
+        Unsigned iota[lanes];
+        for (std::size_t lane = 0 ; lane < lanes ; ++lane)
+        {
+            iota[lane] = static_cast<Unsigned>(start + lane + 1u);
+        }
+        auto positions = Ops::load(iota);
+
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            // The msb stands in for the lowest set bit of the
+            // position 0 reached by the wraparound
+            auto low = Ops::bit_or(positions, top);
+            auto below = Ops::template sub<Unsigned>(Ops::bit_and(low, Ops::template sub<Unsigned>(zero, low)),
+                                                     one);
+            lane_popcount<Unsigned>(Ops{}, below, below);
+            store_bytes<Unsigned>(Ops{}, below, out + i);
+            positions = Ops::template add<Unsigned>(positions, step);
+        }
+        return i;
+    }
+
+#if defined(CPPGRAY_SIMD_DISPATCH) && not defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Kernels passed to run_kernel
+
+    template<std::size_t Bits>
+    struct encode_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, const Unsigned* in, Unsigned* out, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return encode_kernel<Bits>(ops, in, out, size);
+        }
+    };
+
+    template<std::size_t Bits>
+    struct decode_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, const Unsigned* in, Unsigned* out, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return decode_kernel<Bits>(ops, in, out, size);
+        }
+    };
+
+    struct distance_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, Unsigned query, const Unsigned* in,
+                          std::uint8_t* out, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return distance_kernel(ops, query, in, out, size);
+        }
+    };
+
+    struct within_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, Unsigned query, Unsigned radius, const Unsigned* in,
+                          std::size_t* out, std::size_t* found, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return within_kernel(ops, query, radius, in, out, found, size);
+        }
+    };
+
+    template<std::size_t Bits>
+    struct generate_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, Unsigned start, Unsigned* out, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return generate_kernel<Bits>(ops, start, out, size);
+        }
+    };
+
+    struct flips_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, Unsigned start, std::uint8_t* out, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return flips_kernel(ops, start, out, size);
+        }
+    };
+
+    struct parity_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, const Unsigned* in, bool* out, bool odd, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return parity_kernel(ops, in, out, odd, size);
+        }
+    };
+
+    template<std::size_t Bits>
+    struct step_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, Unsigned* codes, bool forward, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return step_kernel<Bits>(ops, codes, forward, size);
+        }
+    };
+
+#if defined(CPPGRAY_USE_EXECUTION_POLICIES) && defined(__cpp_lib_execution)
+    ////////////////////////////////////////////////////////////
+    // Parallel chunks
+    //
+    // Every task converts a chunk small enough to stay in the
+    // L2 cache, yet large enough to make the cost of spawning
+    // the task negligible
+
+    constexpr std::size_t parallel_chunk_bytes = 256 * 1024;
+
+    template<typename ExecutionPolicy, typename Function>
+    auto for_each_chunk(ExecutionPolicy&& policy, std::size_t size,
+                        std::size_t chunk_size, Function func)
+        -> void
+    {
+        if (size <= chunk_size)
+        {
+            func(std::size_t(0), size);
+            return;
+        }
+
+        std::vector<std::size_t> starts((size + chunk_size - 1) / chunk_size);
+        for (std::size_t i = 0 ; i < starts.size() ; ++i)
+        {
+            starts[i] = i * chunk_size;
+        }
+        std::for_each(std::forward<ExecutionPolicy>(policy), starts.begin(), starts.end(),
+                      [&](std::size_t start) {
+                          func(start, std::min(chunk_size, size - start));
+                      });
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////
+// Conversion operations
+
+template<typename Unsigned, std::size_t Bits>
+auto encode(const Unsigned* in, gray_code<Unsigned, Bits>* out, std::size_t size) noexcept
+    -> void
+{
+    static_assert(sizeof(gray_code<Unsigned, Bits>) == sizeof(Unsigned),
+                  "gray_code must have the same layout as its underlying type");
+
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::encode_op<Bits>{},
+                                       in, reinterpret_cast<Unsigned*>(out), size);
+    for (; i < size ; ++i)
+    {
+        out[i] = gray_code<Unsigned, Bits>(in[i]);
+    }
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto decode(const gray_code<Unsigned, Bits>* in, Unsigned* out, std::size_t size) noexcept
+    -> void
+{
+    static_assert(sizeof(gray_code<Unsigned, Bits>) == sizeof(Unsigned),
+                  "gray_code must have the same layout as its underlying type");
+
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::decode_op<Bits>{},
+                                       reinterpret_cast<const Unsigned*>(in), out, size);
+    for (; i < size ; ++i)
+    {
+        out[i] = static_cast<Unsigned>(in[i]);
+    }
+}
+
+#if defined(CPPGRAY_USE_EXECUTION_POLICIES) && defined(__cpp_lib_execution)
+template<typename ExecutionPolicy, typename Unsigned, std::size_t Bits>
+auto encode(ExecutionPolicy&& policy, const Unsigned* in,
+            gray_code<Unsigned, Bits>* out, std::size_t size)
+    -> std::enable_if_t<std::is_execution_policy<std::decay_t<ExecutionPolicy>>::value>
+{
+    constexpr std::size_t chunk_size = detail::parallel_chunk_bytes / sizeof(Unsigned);
+    detail::for_each_chunk(std::forward<ExecutionPolicy>(policy), size, chunk_size,
+                           [=](std::size_t start, std::size_t count) {
+                               encode(in + start, out + start, count);
+                           });
+}
+
+template<typename ExecutionPolicy, typename Unsigned, std::size_t Bits>
+auto decode(ExecutionPolicy&& policy, const gray_code<Unsigned, Bits>* in,
+            Unsigned* out, std::size_t size)
+    -> std::enable_if_t<std::is_execution_policy<std::decay_t<ExecutionPolicy>>::value>
+{
+    constexpr std::size_t chunk_size = detail::parallel_chunk_bytes / sizeof(Unsigned);
+    detail::for_each_chunk(std::forward<ExecutionPolicy>(policy), size, chunk_size,
+                           [=](std::size_t start, std::size_t count) {
+                               decode(in + start, out + start, count);
+                           });
+}
+#endif
+
+////////////////////////////////////////////////////////////
+// Increment/decrement operations
+
+template<typename Unsigned, std::size_t Bits>
+auto increment(gray_code<Unsigned, Bits>* codes, std::size_t size) noexcept
+    -> void
+{
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::step_op<Bits>{},
+                                       reinterpret_cast<Unsigned*>(codes), true, size);
+    for (; i < size ; ++i)
+    {
+        codes[i] = successor(codes[i]);
+    }
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto decrement(gray_code<Unsigned, Bits>* codes, std::size_t size) noexcept
+    -> void
+{
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::step_op<Bits>{},
+                                       reinterpret_cast<Unsigned*>(codes), false, size);
+    for (; i < size ; ++i)
+    {
+        codes[i] = predecessor(codes[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Generation operations
+
+template<typename Unsigned, std::size_t Bits>
+auto generate_gray(Unsigned start, std::size_t size, gray_code<Unsigned, Bits>* out) noexcept
+    -> void
+{
+    static_assert(sizeof(gray_code<Unsigned, Bits>) == sizeof(Unsigned),
+                  "gray_code must have the same layout as its underlying type");
+
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::generate_op<Bits>{},
+                                       start, reinterpret_cast<Unsigned*>(out), size);
+    for (; i < size ; ++i)
+    {
+        out[i] = gray_code<Unsigned, Bits>(static_cast<Unsigned>(start + i));
+    }
+}
+
+template<typename Unsigned>
+auto generate_flips(Unsigned start, std::size_t size, std::uint8_t* out) noexcept
+    -> void
+{
+    constexpr Unsigned msb = Unsigned(1) << (std::numeric_limits<Unsigned>::digits - 1);
+
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::flips_op{},
+                                       start, out, size);
+    for (; i < size ; ++i)
+    {
+        auto low = static_cast<Unsigned>(static_cast<Unsigned>(start + i + 1u) | msb);
+        auto below = static_cast<Unsigned>((low & static_cast<Unsigned>(Unsigned(0) - low)) - 1u);
+        out[i] = static_cast<std::uint8_t>(detail::popcount(below));
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Mathematical functions
+
+template<typename Unsigned, std::size_t Bits>
+auto is_odd(const gray_code<Unsigned, Bits>* in, bool* out, std::size_t size) noexcept
+    -> void
+{
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::parity_op{},
+                                       reinterpret_cast<const Unsigned*>(in), out, true, size);
+    for (; i < size ; ++i)
+    {
+        out[i] = is_odd(in[i]);
+    }
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto is_even(const gray_code<Unsigned, Bits>* in, bool* out, std::size_t size) noexcept
+    -> void
+{
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::parity_op{},
+                                       reinterpret_cast<const Unsigned*>(in), out, false, size);
+    for (; i < size ; ++i)
+    {
+        out[i] = is_even(in[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Neighbourhood functions
+
+template<typename Unsigned, std::size_t Bits>
+auto hamming_distance(gray_code<Unsigned, Bits> query, const gray_code<Unsigned, Bits>* codes,
+                      std::uint8_t* out, std::size_t size) noexcept
+    -> void
+{
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::distance_op{},
+                                       query.value, reinterpret_cast<const Unsigned*>(codes),
+                                       out, size);
+    for (; i < size ; ++i)
+    {
+        out[i] = static_cast<std::uint8_t>(hamming_distance(query, codes[i]));
+    }
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto find_within(gray_code<Unsigned, Bits> query, std::size_t radius,
+                 const gray_code<Unsigned, Bits>* codes, std::size_t size,
+                 std::size_t* out) noexcept
+    -> std::size_t
+{
+    // Every Gray code matches past Bits, and the clamped
+    // radius fits in the smallest lanes
+    if (radius > Bits)
+    {
+        radius = Bits;
+    }
+
+    std::size_t found = 0;
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{}, detail::within_op{},
+                                       query.value, static_cast<Unsigned>(radius),
+                                       reinterpret_cast<const Unsigned*>(codes),
+                                       out, &found, size);
+    for (; i < size ; ++i)
+    {
+        if (hamming_distance(query, codes[i]) <= radius)
+        {
+            out[found++] = i;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_BIG_GRAY_H_
+#define CPPGRAY_BIG_GRAY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include "gray.h"
+#include "detail/simd.h"
+
+namespace cppgray
+{
+    /**
+     * @brief Gray code wider than the built-in integers.
+     *
+     * The Gray code is stored as an array of 64-bit words,
+     * the least significant word first. Encoding only looks
+     * at neighbouring bits and converts every word at once
+     * with SIMD instructions when available. Decoding a bit
+     * depends on the parity of all the bits above it: every
+     * word is decoded independently, then the words whose
+     * higher words have an odd number of bits set are
+     * inverted, from the most significant word down.
+     *
+     * big_gray_code<256>::binary_type bin = {{ 0, 0, 0, 1 }};
+     * big_gray_code<256> gr(bin);
+     * gr.to_binary() == bin;  // true
+     */
+    template<std::size_t Bits>
+    struct big_gray_code
+    {
+        static_assert(Bits > 0, "a Gray code needs at least one bit");
+
+        // Type of the words holding the bits
+        using word_type = std::uint64_t;
+
+        // Number of bits of the Gray code
+        static constexpr std::size_t bits = Bits;
+
+        // Number of words needed to store the Gray code
+        static constexpr std::size_t words = (Bits + 63) / 64;
+
+        // Bits of the most significant word used by the Gray code
+        static constexpr word_type top_mask = ~word_type(0) >> (words * 64 - Bits);
+
+        // Binary integer of Bits bits, least significant word first
+        using binary_type = std::array<word_type, words>;
+
+        // Words of the Gray code, least significant word first
+        binary_type value;
+
+        ////////////////////////////////////////////////////////////
+        // Constructors operations
+
+        // Default constructor, Gray code 0
+        big_gray_code() noexcept;
+
+        /**
+         * @brief Construction from a binary integer.
+         *
+         * The integer is converted to Gray code. The bits of
+         * the most significant word beyond Bits are ignored.
+         *
+         * @param binary Words of the integer to convert
+         */
+        explicit big_gray_code(const binary_type& binary) noexcept;
+
+        /**
+         * @brief Construction from a `bitset`.
+         *
+         * The exact bit representation of the set is used
+         * as the Gray code.
+         *
+         * @param value `bitset` to convert
+         */
+        explicit big_gray_code(const std::bitset<Bits>& value) noexcept;
+
+        ////////////////////////////////////////////////////////////
+        // Conversion operations
+
+        /**
+         * @brief Decodes the Gray code to a binary integer.
+         */
+        auto to_binary() const noexcept
+            -> binary_type;
+
+        explicit operator std::bitset<Bits>() const noexcept;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Comparison operations
+
+    template<std::size_t Bits>
+    auto operator==(const big_gray_code<Bits>& lhs, const big_gray_code<Bits>& rhs) noexcept
+        -> bool;
+
+    template<std::size_t Bits>
+    auto operator!=(const big_gray_code<Bits>& lhs, const big_gray_code<Bits>& rhs) noexcept
+        -> bool;
+
+    ////////////////////////////////////////////////////////////
+    // Utility functions
+
+    template<std::size_t Bits>
+    auto swap(big_gray_code<Bits>& lhs, big_gray_code<Bits>& rhs) noexcept
+        -> void;
+
+    ////////////////////////////////////////////////////////////
+    // Mathematical functions
+
+    template<std::size_t Bits>
+    auto is_odd(const big_gray_code<Bits>& code) noexcept
+        -> bool;
+
+    template<std::size_t Bits>
+    auto is_even(const big_gray_code<Bits>& code) noexcept
+        -> bool;
+
+    #include "big_gray.inl"
+}
+
+#endif // CPPGRAY_BIG_GRAY_H_
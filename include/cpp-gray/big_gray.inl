@@ -0,0 +1,198 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Encodes consecutive words of a multi-word integer, the
+    // lowest bit of every word being combined with the word
+    // above it; the last word is left to the scalar code
+
+    inline auto encode_words_kernel(no_simd_ops, const std::uint64_t*,
+                                    std::uint64_t*, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+    template<typename Ops>
+    auto encode_words_kernel(Ops, const std::uint64_t* in,
+                             std::uint64_t* out, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(std::uint64_t);
+
+        std::size_t i = 0;
+        for (; i + lanes < size ; i += lanes)
+        {
+            auto v = Ops::load(in + i);
+            auto next = Ops::load(in + i + 1);
+            v = Ops::bit_xor(v, Ops::template shift_right<std::uint64_t>(v, 1));
+            v = Ops::bit_xor(v, Ops::template shift_left<std::uint64_t>(next, 63));
+            Ops::store(out + i, v);
+        }
+        return i;
+    }
+
+    inline auto encode_words(const std::uint64_t* in, std::uint64_t* out,
+                             std::size_t size) noexcept
+        -> void
+    {
+        std::size_t i = encode_words_kernel(simd_ops_for_t<std::uint64_t>{}, in, out, size);
+        for (; i < size - 1 ; ++i)
+        {
+            out[i] = in[i] ^ (in[i] >> 1) ^ (in[i + 1] << 63);
+        }
+        out[size - 1] = in[size - 1] ^ (in[size - 1] >> 1);
+    }
+
+    inline auto decode_words(const std::uint64_t* in, std::uint64_t* out,
+                             std::size_t size) noexcept
+        -> void
+    {
+        // Every word is decoded on its own, then the parity of
+        // the Gray code bits above it, which is the lowest bit
+        // of the decoded word above, is carried to all its bits
+        std::uint64_t carry = 0;
+        for (std::size_t i = size ; i-- > 0 ;)
+        {
+            gray_code<std::uint64_t> code;
+            code.value = in[i];
+            out[i] = static_cast<std::uint64_t>(code) ^ (std::uint64_t(0) - carry);
+            carry = out[i] & 1;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Out-of-class definitions of static data members
+
+template<std::size_t Bits>
+constexpr std::size_t big_gray_code<Bits>::bits;
+
+template<std::size_t Bits>
+constexpr std::size_t big_gray_code<Bits>::words;
+
+template<std::size_t Bits>
+constexpr typename big_gray_code<Bits>::word_type big_gray_code<Bits>::top_mask;
+
+////////////////////////////////////////////////////////////
+// Construction operations
+
+template<std::size_t Bits>
+big_gray_code<Bits>::big_gray_code() noexcept:
+    value()
+{}
+
+template<std::size_t Bits>
+big_gray_code<Bits>::big_gray_code(const binary_type& binary) noexcept
+{
+    binary_type masked = binary;
+    masked[words - 1] &= top_mask;
+    detail::encode_words(masked.data(), value.data(), words);
+}
+
+template<std::size_t Bits>
+big_gray_code<Bits>::big_gray_code(const std::bitset<Bits>& value) noexcept
+{
+    for (std::size_t i = 0 ; i < words ; ++i)
+    {
+        this->value[i] = detail::bitset_low_bits<word_type>(value >> (i * 64));
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Conversion operations
+
+template<std::size_t Bits>
+auto big_gray_code<Bits>::to_binary() const noexcept
+    -> binary_type
+{
+    binary_type res;
+    detail::decode_words(value.data(), res.data(), words);
+    return res;
+}
+
+template<std::size_t Bits>
+big_gray_code<Bits>::operator std::bitset<Bits>() const noexcept
+{
+    std::bitset<Bits> res;
+    for (std::size_t i = words ; i-- > 0 ;)
+    {
+        res <<= 64;
+        res |= std::bitset<Bits>(value[i]);
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////
+// Comparison operations
+
+template<std::size_t Bits>
+auto operator==(const big_gray_code<Bits>& lhs, const big_gray_code<Bits>& rhs) noexcept
+    -> bool
+{
+    return lhs.value == rhs.value;
+}
+
+template<std::size_t Bits>
+auto operator!=(const big_gray_code<Bits>& lhs, const big_gray_code<Bits>& rhs) noexcept
+    -> bool
+{
+    return lhs.value != rhs.value;
+}
+
+////////////////////////////////////////////////////////////
+// Utility functions
+
+template<std::size_t Bits>
+auto swap(big_gray_code<Bits>& lhs, big_gray_code<Bits>& rhs) noexcept
+    -> void
+{
+    lhs.value.swap(rhs.value);
+}
+
+////////////////////////////////////////////////////////////
+// Mathematical functions
+
+template<std::size_t Bits>
+auto is_odd(const big_gray_code<Bits>& code) noexcept
+    -> bool
+{
+    std::uint64_t folded = 0;
+    for (auto word: code.value)
+    {
+        folded ^= word;
+    }
+    return detail::parity(folded);
+}
+
+template<std::size_t Bits>
+auto is_even(const big_gray_code<Bits>& code) noexcept
+    -> bool
+{
+    return not is_odd(code);
+}
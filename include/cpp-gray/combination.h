@@ -0,0 +1,252 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_COMBINATION_H_
+#define CPPGRAY_COMBINATION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include "gray.h"
+
+namespace cppgray
+{
+    /**
+     * @brief Iterator over the k-subsets of a set in revolving-door order.
+     *
+     * Moving from a subset to the next one removes exactly one
+     * element and adds exactly one element (the "revolving door").
+     * The order is the one of the reflected Gray codes of n bits
+     * once the codes that don't have exactly k bits set have been
+     * skipped, so the iterator produces Gray codes, and it can tell
+     * which bits were exchanged in the last step, much like the
+     * flipped bit of gray_iterator.
+     *
+     * The iterator follows Knuth's Algorithm R (The Art of Computer
+     * Programming, 7.2.1.3) and takes amortized constant time per
+     * step. It is only a forward iterator, and it returns the Gray
+     * codes by value, so its iterator_category is input_iterator_tag
+     * while its iterator_concept is forward_iterator_tag.
+     *
+     * auto it = revolving_door_range<unsigned>(4, 2).begin();
+     * // (*it).value == 0b0011
+     * ++it;                // (*it).value == 0b0110
+     * it.added_bit();      // 2
+     * it.removed_bit();    // 0
+     */
+    template<typename Unsigned>
+    class revolving_door_iterator
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using iterator_concept  = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = gray_code<Unsigned>;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = gray_code<Unsigned>;
+
+            // Position of a subset in the sequence
+            using position_type     = std::uint64_t;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            constexpr revolving_door_iterator() noexcept;
+
+            /**
+             * @brief Iterator to the first k-subset of a set of n elements.
+             *
+             * The first subset holds the elements [0, k).
+             *
+             * @param n Number of elements of the set, no greater than
+             *        the number of bits of Unsigned
+             * @param k Number of elements of the subsets, no greater than n
+             */
+            constexpr revolving_door_iterator(std::size_t n, std::size_t k) noexcept;
+
+            /**
+             * @brief Iterator comparing equal to the subset at a given position.
+             *
+             * Such an iterator can't be dereferenced nor incremented; it is
+             * mostly meant to be used as the end of a range.
+             *
+             * @param position Position in the sequence of subsets
+             */
+            constexpr explicit revolving_door_iterator(position_type position) noexcept;
+
+            ////////////////////////////////////////////////////////////
+            // Element access
+
+            constexpr auto operator*() const noexcept
+                -> reference;
+
+            /**
+             * @brief Position of the current subset in the sequence.
+             */
+            constexpr auto position() const noexcept
+                -> position_type;
+
+            /**
+             * @brief Element added to reach the current subset.
+             *
+             * The first subset of the sequence has no predecessor,
+             * in which case the function returns 64.
+             */
+            constexpr auto added_bit() const noexcept
+                -> int;
+
+            /**
+             * @brief Element removed to reach the current subset.
+             *
+             * The first subset of the sequence has no predecessor,
+             * in which case the function returns 64.
+             */
+            constexpr auto removed_bit() const noexcept
+                -> int;
+
+            ////////////////////////////////////////////////////////////
+            // Increment operations
+
+            constexpr auto operator++() noexcept
+                -> revolving_door_iterator&;
+            constexpr auto operator++(int) noexcept
+                -> revolving_door_iterator;
+
+            ////////////////////////////////////////////////////////////
+            // Comparison operations
+
+            friend constexpr auto operator==(const revolving_door_iterator& lhs,
+                                             const revolving_door_iterator& rhs) noexcept
+                -> bool
+            {
+                return lhs._position == rhs._position;
+            }
+
+            friend constexpr auto operator!=(const revolving_door_iterator& lhs,
+                                             const revolving_door_iterator& rhs) noexcept
+                -> bool
+            {
+                return lhs._position != rhs._position;
+            }
+
+        private:
+
+            position_type _position;
+            gray_code<Unsigned> _code;
+            int _added;
+            int _removed;
+            std::uint8_t _k;
+            // Elements of the subset in increasing order from index 1,
+            // followed by n
+            std::uint8_t _elements[66];
+    };
+
+    /**
+     * @brief Range of the k-subsets of a set in revolving-door order.
+     *
+     * The range is lazy and does not allocate; its size is the
+     * binomial coefficient C(n, k).
+     *
+     * for (auto code: revolving_door_range<unsigned>(4, 2)) {
+     *     // 0b0011, 0b0110, 0b0101, 0b1100, 0b1010, 0b1001
+     * }
+     */
+    template<typename Unsigned>
+    class revolving_door_range
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using iterator      = revolving_door_iterator<Unsigned>;
+            using value_type    = gray_code<Unsigned>;
+            using size_type     = typename iterator::position_type;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            /**
+             * @brief Range of the k-subsets of a set of n elements.
+             *
+             * @param n Number of elements of the set, no greater than
+             *        the number of bits of Unsigned
+             * @param k Number of elements of the subsets, no greater than n
+             */
+            constexpr revolving_door_range(std::size_t n, std::size_t k) noexcept;
+
+            ////////////////////////////////////////////////////////////
+            // Iterators
+
+            constexpr auto begin() const noexcept
+                -> iterator;
+            constexpr auto end() const noexcept
+                -> iterator;
+
+            ////////////////////////////////////////////////////////////
+            // Capacity
+
+            constexpr auto size() const noexcept
+                -> size_type;
+            constexpr auto empty() const noexcept
+                -> bool;
+
+        private:
+
+            std::size_t _n;
+            std::size_t _k;
+            size_type _size;
+    };
+
+    /**
+     * @brief Calls a function for every exchange of a revolving-door sequence.
+     *
+     * Enumerating the k-subsets of a set of n elements in
+     * revolving-door order exchanges exactly one element at
+     * each step: this function calls func with the element
+     * added and the element removed at each of these C(n, k) - 1
+     * steps, starting from the subset [0, k). It is the cheapest
+     * way to evaluate a function incrementally over every
+     * k-subset.
+     *
+     * @param n Number of elements of the set, no greater than 64
+     * @param k Number of elements of the subsets, no greater than n
+     * @param func Function called as func(added, removed)
+     * @return func
+     */
+    template<typename Function>
+    constexpr auto for_each_revolving_door_swap(std::size_t n, std::size_t k, Function func)
+        -> Function;
+
+    #include "combination.inl"
+}
+
+#endif // CPPGRAY_COMBINATION_H_
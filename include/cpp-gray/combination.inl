@@ -0,0 +1,281 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Binomial coefficient computed with a row of Pascal's
+    // triangle, which never overflows for n <= 64
+    constexpr auto binomial(std::size_t n, std::size_t k) noexcept
+        -> std::uint64_t
+    {
+        if (k > n)
+        {
+            return 0;
+        }
+
+        std::uint64_t row[65] = { 1 };
+        for (std::size_t i = 1 ; i <= n ; ++i)
+        {
+            for (std::size_t j = i < k ? i : k ; j > 0 ; --j)
+            {
+                row[j] += row[j - 1];
+            }
+        }
+        return row[k];
+    }
+
+    // Sets the first subset [0, k) of n elements: elements[1..k]
+    // hold the subset and elements[k + 1] holds n
+    constexpr auto revolving_door_init(std::uint8_t* elements, std::size_t n, std::size_t k) noexcept
+        -> void
+    {
+        for (std::size_t j = 1 ; j <= k ; ++j)
+        {
+            elements[j] = static_cast<std::uint8_t>(j - 1);
+        }
+        elements[k + 1] = static_cast<std::uint8_t>(n);
+    }
+
+    // One step of Algorithm R: the first element moves back and
+    // forth along its free cells most of the time, otherwise the
+    // lowest element that can move does. Returns false when the
+    // current subset is the last one
+    constexpr auto revolving_door_step(std::uint8_t* elements, std::size_t k,
+                                       int& added, int& removed) noexcept
+        -> bool
+    {
+        // A subset of every element or of no element is alone
+        if (k == 0 || elements[k + 1] == k)
+        {
+            return false;
+        }
+
+        auto* c = elements;
+        if (k % 2 == 1)
+        {
+            if (c[1] + 1 < c[2])
+            {
+                removed = c[1];
+                added = ++c[1];
+                return true;
+            }
+        }
+        else if (c[1] > 0)
+        {
+            removed = c[1];
+            added = --c[1];
+            return true;
+        }
+
+        // Alternately try to decrease and to increase the
+        // next elements, starting with a decrease when k
+        // is odd and with an increase otherwise
+        bool decrease = k % 2 == 1;
+        for (std::size_t j = 2 ; j <= k ; ++j, decrease = not decrease)
+        {
+            if (decrease)
+            {
+                // Here c[j] == c[j - 1] + 1
+                if (c[j] >= j)
+                {
+                    removed = c[j];
+                    c[j] = c[j - 1];
+                    c[j - 1] = static_cast<std::uint8_t>(j - 2);
+                    added = c[j - 1];
+                    return true;
+                }
+            }
+            else
+            {
+                // Here c[j - 1] == j - 2
+                if (c[j] + 1 < c[j + 1])
+                {
+                    removed = c[j - 1];
+                    c[j - 1] = c[j];
+                    added = ++c[j];
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+}
+
+////////////////////////////////////////////////////////////
+// revolving_door_iterator construction
+
+template<typename Unsigned>
+constexpr revolving_door_iterator<Unsigned>::revolving_door_iterator() noexcept:
+    _position(0),
+    _code(),
+    _added(64),
+    _removed(64),
+    _k(0),
+    _elements{}
+{}
+
+template<typename Unsigned>
+constexpr revolving_door_iterator<Unsigned>::revolving_door_iterator(std::size_t n,
+                                                                     std::size_t k) noexcept:
+    _position(0),
+    _code(),
+    _added(64),
+    _removed(64),
+    _k(static_cast<std::uint8_t>(k)),
+    _elements{}
+{
+    detail::revolving_door_init(_elements, n, k);
+    _code.value = k ? static_cast<Unsigned>(static_cast<Unsigned>(~Unsigned(0)) >> (std::numeric_limits<Unsigned>::digits - k)) : 0;
+}
+
+template<typename Unsigned>
+constexpr revolving_door_iterator<Unsigned>::revolving_door_iterator(position_type position) noexcept:
+    _position(position),
+    _code(),
+    _added(64),
+    _removed(64),
+    _k(0),
+    _elements{}
+{}
+
+////////////////////////////////////////////////////////////
+// revolving_door_iterator element access
+
+template<typename Unsigned>
+constexpr auto revolving_door_iterator<Unsigned>::operator*() const noexcept
+    -> reference
+{
+    return _code;
+}
+
+template<typename Unsigned>
+constexpr auto revolving_door_iterator<Unsigned>::position() const noexcept
+    -> position_type
+{
+    return _position;
+}
+
+template<typename Unsigned>
+constexpr auto revolving_door_iterator<Unsigned>::added_bit() const noexcept
+    -> int
+{
+    return _added;
+}
+
+template<typename Unsigned>
+constexpr auto revolving_door_iterator<Unsigned>::removed_bit() const noexcept
+    -> int
+{
+    return _removed;
+}
+
+////////////////////////////////////////////////////////////
+// revolving_door_iterator increment operations
+
+template<typename Unsigned>
+constexpr auto revolving_door_iterator<Unsigned>::operator++() noexcept
+    -> revolving_door_iterator&
+{
+    ++_position;
+    if (detail::revolving_door_step(_elements, _k, _added, _removed))
+    {
+        _code.value ^= static_cast<Unsigned>((Unsigned(1) << _added) | (Unsigned(1) << _removed));
+    }
+    return *this;
+}
+
+template<typename Unsigned>
+constexpr auto revolving_door_iterator<Unsigned>::operator++(int) noexcept
+    -> revolving_door_iterator
+{
+    auto res = *this;
+    operator++();
+    return res;
+}
+
+////////////////////////////////////////////////////////////
+// revolving_door_range construction
+
+template<typename Unsigned>
+constexpr revolving_door_range<Unsigned>::revolving_door_range(std::size_t n, std::size_t k) noexcept:
+    _n(n),
+    _k(k),
+    _size(detail::binomial(n, k))
+{}
+
+////////////////////////////////////////////////////////////
+// revolving_door_range iterators
+
+template<typename Unsigned>
+constexpr auto revolving_door_range<Unsigned>::begin() const noexcept
+    -> iterator
+{
+    return iterator(_n, _k);
+}
+
+template<typename Unsigned>
+constexpr auto revolving_door_range<Unsigned>::end() const noexcept
+    -> iterator
+{
+    return iterator(_size);
+}
+
+////////////////////////////////////////////////////////////
+// revolving_door_range capacity
+
+template<typename Unsigned>
+constexpr auto revolving_door_range<Unsigned>::size() const noexcept
+    -> size_type
+{
+    return _size;
+}
+
+template<typename Unsigned>
+constexpr auto revolving_door_range<Unsigned>::empty() const noexcept
+    -> bool
+{
+    return _size == 0;
+}
+
+////////////////////////////////////////////////////////////
+// Exchange enumeration
+
+template<typename Function>
+constexpr auto for_each_revolving_door_swap(std::size_t n, std::size_t k, Function func)
+    -> Function
+{
+    std::uint8_t elements[66] = {};
+    detail::revolving_door_init(elements, n, k);
+
+    int added = 64;
+    int removed = 64;
+    while (detail::revolving_door_step(elements, k, added, removed))
+    {
+        func(added, removed);
+    }
+    return func;
+}
@@ -0,0 +1,133 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_DETAIL_CONFIG_H_
+#define CPPGRAY_DETAIL_CONFIG_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <type_traits>
+
+////////////////////////////////////////////////////////////
+// Detection of constant evaluation
+//
+// Intrinsics can't be used in constant expressions, so the
+// functions using them have to know whether they are being
+// evaluated at compile time to fall back to portable code
+
+#if defined(__has_builtin)
+#   if __has_builtin(__builtin_is_constant_evaluated)
+#       define CPPGRAY_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#   endif
+#endif
+
+#if not defined(CPPGRAY_IS_CONSTANT_EVALUATED)
+#   if defined(__GNUC__) && __GNUC__ >= 9
+#       define CPPGRAY_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#   elif defined(__cpp_lib_is_constant_evaluated)
+#       define CPPGRAY_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#   endif
+#endif
+
+////////////////////////////////////////////////////////////
+// Three-way comparison
+
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+#   if defined(__has_include)
+#       if __has_include(<compare>)
+#           define CPPGRAY_HAS_THREE_WAY_COMPARISON 1
+#       endif
+#   endif
+#endif
+
+////////////////////////////////////////////////////////////
+// Device code
+//
+// With CUDA and HIP, the scalar operations are marked with
+// CPPGRAY_HOST_DEVICE so that kernels can call them; the
+// macro can be predefined for other toolchains. Host
+// intrinsics are not available while compiling for the
+// device, which uses its own intrinsics instead
+
+#if not defined(CPPGRAY_HOST_DEVICE)
+#   if defined(__CUDACC__) || defined(__HIPCC__)
+#       define CPPGRAY_HOST_DEVICE __host__ __device__
+#   else
+#       define CPPGRAY_HOST_DEVICE
+#   endif
+#endif
+
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+#   define CPPGRAY_DEVICE_CODE 1
+#   if defined(CPPGRAY_IS_CONSTANT_EVALUATED)
+#       define CPPGRAY_HAS_DEVICE_INTRINSICS 1
+#   endif
+#endif
+
+////////////////////////////////////////////////////////////
+// Carry-less multiplication
+
+#if defined(CPPGRAY_IS_CONSTANT_EVALUATED) && not defined(CPPGRAY_DEVICE_CODE)
+#   if defined(__PCLMUL__) && defined(__x86_64__)
+#       define CPPGRAY_HAS_CLMUL 1
+#       include <wmmintrin.h>
+#   elif defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#       define CPPGRAY_HAS_CLMUL 1
+#       include <arm_neon.h>
+#   endif
+#endif
+
+////////////////////////////////////////////////////////////
+// Bit deposit and extract
+
+#if defined(CPPGRAY_IS_CONSTANT_EVALUATED) && defined(__BMI2__) && defined(__x86_64__) && \
+    not defined(CPPGRAY_DEVICE_CODE)
+#   define CPPGRAY_HAS_BMI2 1
+#   include <immintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////
+// 128-bit integers
+//
+// GCC and Clang provide unsigned __int128 on 64-bit targets,
+// but the standard type traits reject it in strict modes
+
+#if defined(__SIZEOF_INT128__)
+#   define CPPGRAY_HAS_INT128 1
+#endif
+
+////////////////////////////////////////////////////////////
+// Population count with MSVC
+//
+// MSVC has no constexpr parity intrinsic, and __popcnt64
+// emits POPCNT unconditionally: it is only used when the
+// target is known to support it
+
+#if defined(_MSC_VER) && not defined(__clang__) && defined(_M_X64) && \
+    defined(__AVX__) && defined(CPPGRAY_IS_CONSTANT_EVALUATED)
+#   define CPPGRAY_HAS_MSVC_POPCNT 1
+#   include <intrin.h>
+#endif
+
+#endif // CPPGRAY_DETAIL_CONFIG_H_
@@ -0,0 +1,177 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_DETAIL_DISPATCH_H_
+#define CPPGRAY_DETAIL_DISPATCH_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include "simd.h"
+#if defined(CPPGRAY_SIMD_DISPATCH)
+#   include <atomic>
+#endif
+
+#if defined(CPPGRAY_SIMD_DISPATCH)
+#   define CPPGRAY_SIMD_TARGET(isa) __attribute__((target(isa), flatten))
+#endif
+
+namespace cppgray
+{
+namespace detail
+{
+    /*
+     * Batch kernels are written as structs with a static apply
+     * function template taking the ops of an instruction set as
+     * first parameter. run_kernel calls it with the best ops
+     * available at compile time.
+     *
+     * When CPPGRAY_RUNTIME_DISPATCH is defined on x86-64, every
+     * kernel is instead compiled once for SSE2, AVX2 and AVX-512,
+     * and called through a function pointer. That pointer first
+     * points to a resolver which checks the instruction sets the
+     * CPU supports, binds the best version of the kernel to the
+     * pointer and runs it: afterwards every call goes directly to
+     * the selected kernel.
+     */
+
+#if defined(CPPGRAY_SIMD_DISPATCH)
+    enum class simd_level
+    {
+        sse2,
+        avx2,
+        avx512
+    };
+
+    inline auto detect_simd_level() noexcept
+        -> simd_level
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        {
+            return simd_level::avx512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return simd_level::avx2;
+        }
+        return simd_level::sse2;
+    }
+
+    // Only computed the first time a kernel is resolved
+    inline auto runtime_simd_level() noexcept
+        -> simd_level
+    {
+        static const simd_level level = detect_simd_level();
+        return level;
+    }
+
+    template<typename Kernel, typename Signature>
+    struct dispatcher;
+
+    template<typename Kernel, typename... Args>
+    struct dispatcher<Kernel, std::size_t(Args...)>
+    {
+        using function_type = std::size_t(*)(Args...);
+
+        // The whole kernel is inlined into every one of these
+        // functions so that it is compiled for their target
+
+        CPPGRAY_SIMD_TARGET("sse2")
+        static auto run_sse2(Args... args) noexcept
+            -> std::size_t
+        {
+            return Kernel::apply(sse2_ops{}, args...);
+        }
+
+        CPPGRAY_SIMD_TARGET("avx2")
+        static auto run_avx2(Args... args) noexcept
+            -> std::size_t
+        {
+            return Kernel::apply(avx2_ops{}, args...);
+        }
+
+        CPPGRAY_SIMD_TARGET("avx512f,avx512bw")
+        static auto run_avx512(Args... args) noexcept
+            -> std::size_t
+        {
+            return Kernel::apply(avx512_ops{}, args...);
+        }
+
+        static auto select(simd_level level) noexcept
+            -> function_type
+        {
+            switch (level)
+            {
+                case simd_level::avx512:
+                    return &run_avx512;
+                case simd_level::avx2:
+                    return &run_avx2;
+                default:
+                    return &run_sse2;
+            }
+        }
+
+        // Several threads may resolve the kernel at once, they
+        // all store the same pointer
+        static auto resolve(Args... args) noexcept
+            -> std::size_t
+        {
+            function_type func = select(runtime_simd_level());
+            kernel.store(func, std::memory_order_relaxed);
+            return func(args...);
+        }
+
+        static std::atomic<function_type> kernel;
+    };
+
+    template<typename Kernel, typename... Args>
+    std::atomic<std::size_t(*)(Args...)> dispatcher<Kernel, std::size_t(Args...)>::kernel{
+        &dispatcher<Kernel, std::size_t(Args...)>::resolve
+    };
+#endif
+
+    // Lanes wider than 64 bits are never vectorized, so there
+    // is nothing to dispatch
+    template<typename Kernel, typename... Args>
+    auto run_kernel(no_simd_ops ops, Kernel, Args... args) noexcept
+        -> std::size_t
+    {
+        return Kernel::apply(ops, args...);
+    }
+
+    template<typename Ops, typename Kernel, typename... Args>
+    auto run_kernel(Ops ops, Kernel, Args... args) noexcept
+        -> std::size_t
+    {
+#if defined(CPPGRAY_SIMD_DISPATCH)
+        static_cast<void>(ops);
+        return dispatcher<Kernel, std::size_t(Args...)>::kernel.load(std::memory_order_relaxed)(args...);
+#else
+        return Kernel::apply(ops, args...);
+#endif
+    }
+}}
+
+#endif // CPPGRAY_DETAIL_DISPATCH_H_
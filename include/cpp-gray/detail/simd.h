@@ -0,0 +1,952 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_DETAIL_SIMD_H_
+#define CPPGRAY_DETAIL_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX512F__)
+#   define CPPGRAY_SIMD_AVX512F 1
+#endif
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#   define CPPGRAY_SIMD_AVX512BW 1
+#endif
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+#   define CPPGRAY_SIMD_AVX512VPOPCNTDQ 1
+#endif
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512BITALG__)
+#   define CPPGRAY_SIMD_AVX512BITALG 1
+#endif
+#if defined(__AVX2__)
+#   define CPPGRAY_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define CPPGRAY_SIMD_SSE2 1
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define CPPGRAY_SIMD_NEON 1
+#endif
+
+// With CPPGRAY_RUNTIME_DISPATCH on x86-64, the AVX2 and AVX-512
+// ops are always defined, compiled for their instruction set with
+// target pragmas, and only used once the CPU has been checked to
+// support them; NEON is part of the AArch64 baseline and doesn't
+// need any dispatch
+#if defined(CPPGRAY_RUNTIME_DISPATCH) && defined(CPPGRAY_SIMD_SSE2) && \
+    defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#   define CPPGRAY_SIMD_DISPATCH 1
+#endif
+#if defined(CPPGRAY_SIMD_AVX2) || defined(CPPGRAY_SIMD_DISPATCH)
+#   define CPPGRAY_SIMD_AVX2_OPS 1
+#endif
+#if defined(CPPGRAY_SIMD_AVX512F) || defined(CPPGRAY_SIMD_DISPATCH)
+#   define CPPGRAY_SIMD_AVX512_OPS 1
+#endif
+#if defined(CPPGRAY_SIMD_AVX512BW) || defined(CPPGRAY_SIMD_DISPATCH)
+#   define CPPGRAY_SIMD_AVX512BW_OPS 1
+#endif
+
+#if defined(CPPGRAY_SIMD_DISPATCH) && defined(__clang__)
+#   define CPPGRAY_SIMD_TARGET_PUSH_AVX2 \
+        _Pragma("clang attribute push(__attribute__((target(\"avx2\"))), apply_to = function)")
+#   define CPPGRAY_SIMD_TARGET_PUSH_AVX512 \
+        _Pragma("clang attribute push(__attribute__((target(\"avx512f,avx512bw\"))), apply_to = function)")
+#   define CPPGRAY_SIMD_TARGET_POP _Pragma("clang attribute pop")
+#elif defined(CPPGRAY_SIMD_DISPATCH)
+#   define CPPGRAY_SIMD_TARGET_PUSH_AVX2 \
+        _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#   define CPPGRAY_SIMD_TARGET_PUSH_AVX512 \
+        _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx512bw\")")
+#   define CPPGRAY_SIMD_TARGET_POP _Pragma("GCC pop_options")
+#endif
+
+#if defined(CPPGRAY_SIMD_SSE2) || defined(CPPGRAY_SIMD_AVX2_OPS) || defined(CPPGRAY_SIMD_AVX512_OPS)
+#   include <immintrin.h>
+#endif
+#if defined(CPPGRAY_SIMD_NEON)
+#   include <arm_neon.h>
+#endif
+
+namespace cppgray
+{
+namespace detail
+{
+    /*
+     * Every SIMD instruction set is wrapped in a small struct
+     * exposing the same set of static functions, which allows
+     * the batch kernels to be written once for every one of
+     * them. Lane-wise operations take the lane type as a
+     * template parameter since most instruction sets have one
+     * instruction per lane width.
+     */
+
+    template<std::size_t N>
+    using lane_width = std::integral_constant<std::size_t, N>;
+
+    // Fallback used when no SIMD instruction set is available
+    struct no_simd_ops {};
+
+#if defined(CPPGRAY_SIMD_SSE2)
+    struct sse2_ops
+    {
+        using vector = __m128i;
+        static constexpr std::size_t size = 16;
+
+        static auto load(const void* ptr) noexcept
+            -> vector
+        {
+            return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+        }
+
+        static auto store(void* ptr, vector v) noexcept
+            -> void
+        {
+            _mm_storeu_si128(static_cast<__m128i*>(ptr), v);
+        }
+
+        static auto bit_and(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm_and_si128(lhs, rhs);
+        }
+
+        static auto bit_or(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm_or_si128(lhs, rhs);
+        }
+
+        static auto bit_xor(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm_xor_si128(lhs, rhs);
+        }
+
+        // lhs & ~rhs
+        static auto bit_andnot(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm_andnot_si128(rhs, lhs);
+        }
+
+        template<typename Unsigned>
+        static auto broadcast(Unsigned value) noexcept
+            -> vector
+        {
+            return broadcast(value, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto add(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return add(lhs, rhs, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto sub(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return sub(lhs, rhs, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto shift_right(vector v, int count) noexcept
+            -> vector
+        {
+            return shift_right(v, count, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto shift_left(vector v, int count) noexcept
+            -> vector
+        {
+            return shift_left(v, count, lane_width<sizeof(Unsigned)>{});
+        }
+
+        // Bitmask made of the most significant bit of every lane
+        template<typename Unsigned>
+        static auto msb_mask(vector v) noexcept
+            -> std::uint64_t
+        {
+            return msb_mask(v, lane_width<sizeof(Unsigned)>{});
+        }
+
+    private:
+
+        static auto msb_mask(vector v, lane_width<1>) noexcept
+            -> std::uint64_t
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(v));
+        }
+
+        static auto msb_mask(vector v, lane_width<2>) noexcept
+            -> std::uint64_t
+        {
+            auto bytes = _mm_packs_epi16(_mm_srai_epi16(v, 15), _mm_setzero_si128());
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+        }
+
+        static auto msb_mask(vector v, lane_width<4>) noexcept
+            -> std::uint64_t
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(v)));
+        }
+
+        static auto msb_mask(vector v, lane_width<8>) noexcept
+            -> std::uint64_t
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(v)));
+        }
+
+        static auto broadcast(std::uint8_t value, lane_width<1>) noexcept
+            -> vector
+        {
+            return _mm_set1_epi8(static_cast<char>(value));
+        }
+
+        static auto broadcast(std::uint16_t value, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm_set1_epi16(static_cast<short>(value));
+        }
+
+        static auto broadcast(std::uint32_t value, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm_set1_epi32(static_cast<int>(value));
+        }
+
+        static auto broadcast(std::uint64_t value, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm_set1_epi64x(static_cast<long long>(value));
+        }
+
+        static auto add(vector lhs, vector rhs, lane_width<1>) noexcept -> vector { return _mm_add_epi8(lhs, rhs); }
+        static auto add(vector lhs, vector rhs, lane_width<2>) noexcept -> vector { return _mm_add_epi16(lhs, rhs); }
+        static auto add(vector lhs, vector rhs, lane_width<4>) noexcept -> vector { return _mm_add_epi32(lhs, rhs); }
+        static auto add(vector lhs, vector rhs, lane_width<8>) noexcept -> vector { return _mm_add_epi64(lhs, rhs); }
+
+        static auto sub(vector lhs, vector rhs, lane_width<1>) noexcept -> vector { return _mm_sub_epi8(lhs, rhs); }
+        static auto sub(vector lhs, vector rhs, lane_width<2>) noexcept -> vector { return _mm_sub_epi16(lhs, rhs); }
+        static auto sub(vector lhs, vector rhs, lane_width<4>) noexcept -> vector { return _mm_sub_epi32(lhs, rhs); }
+        static auto sub(vector lhs, vector rhs, lane_width<8>) noexcept -> vector { return _mm_sub_epi64(lhs, rhs); }
+
+        // There is no 8-bit shift, so a 16-bit one is used and
+        // the bits that crossed a lane boundary are cleared
+        static auto shift_right(vector v, int count, lane_width<1>) noexcept
+            -> vector
+        {
+            auto mask = _mm_set1_epi8(static_cast<char>(0xff >> count));
+            return _mm_and_si128(_mm_srl_epi16(v, _mm_cvtsi32_si128(count)), mask);
+        }
+
+        static auto shift_right(vector v, int count, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm_srl_epi16(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_right(vector v, int count, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm_srl_epi32(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_right(vector v, int count, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm_srl_epi64(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<1>) noexcept
+            -> vector
+        {
+            auto mask = _mm_set1_epi8(static_cast<char>((0xff << count) & 0xff));
+            return _mm_and_si128(_mm_sll_epi16(v, _mm_cvtsi32_si128(count)), mask);
+        }
+
+        static auto shift_left(vector v, int count, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm_sll_epi16(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm_sll_epi32(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm_sll_epi64(v, _mm_cvtsi32_si128(count));
+        }
+    };
+#endif
+
+#if defined(CPPGRAY_SIMD_AVX2_OPS)
+#   if defined(CPPGRAY_SIMD_DISPATCH) && not defined(CPPGRAY_SIMD_AVX2)
+    CPPGRAY_SIMD_TARGET_PUSH_AVX2
+#   endif
+    struct avx2_ops
+    {
+        using vector = __m256i;
+        static constexpr std::size_t size = 32;
+
+        static auto load(const void* ptr) noexcept
+            -> vector
+        {
+            return _mm256_loadu_si256(static_cast<const __m256i*>(ptr));
+        }
+
+        static auto store(void* ptr, vector v) noexcept
+            -> void
+        {
+            _mm256_storeu_si256(static_cast<__m256i*>(ptr), v);
+        }
+
+        static auto bit_and(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm256_and_si256(lhs, rhs);
+        }
+
+        static auto bit_or(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm256_or_si256(lhs, rhs);
+        }
+
+        static auto bit_xor(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm256_xor_si256(lhs, rhs);
+        }
+
+        // lhs & ~rhs
+        static auto bit_andnot(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm256_andnot_si256(rhs, lhs);
+        }
+
+        template<typename Unsigned>
+        static auto broadcast(Unsigned value) noexcept
+            -> vector
+        {
+            return broadcast(value, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto add(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return add(lhs, rhs, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto sub(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return sub(lhs, rhs, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto shift_right(vector v, int count) noexcept
+            -> vector
+        {
+            return shift_right(v, count, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto shift_left(vector v, int count) noexcept
+            -> vector
+        {
+            return shift_left(v, count, lane_width<sizeof(Unsigned)>{});
+        }
+
+        // Bitmask made of the most significant bit of every lane
+        template<typename Unsigned>
+        static auto msb_mask(vector v) noexcept
+            -> std::uint64_t
+        {
+            return msb_mask(v, lane_width<sizeof(Unsigned)>{});
+        }
+
+    private:
+
+        static auto msb_mask(vector v, lane_width<1>) noexcept
+            -> std::uint64_t
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+        }
+
+        static auto msb_mask(vector v, lane_width<2>) noexcept
+            -> std::uint64_t
+        {
+            // Packing works within 128-bit lanes, so the bits of
+            // the upper half end up in the third byte of the mask
+            auto bytes = _mm256_packs_epi16(_mm256_srai_epi16(v, 15), _mm256_setzero_si256());
+            auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(bytes));
+            return (mask & 0xffu) | ((mask >> 8) & 0xff00u);
+        }
+
+        static auto msb_mask(vector v, lane_width<4>) noexcept
+            -> std::uint64_t
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(v)));
+        }
+
+        static auto msb_mask(vector v, lane_width<8>) noexcept
+            -> std::uint64_t
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+        }
+
+        static auto broadcast(std::uint8_t value, lane_width<1>) noexcept
+            -> vector
+        {
+            return _mm256_set1_epi8(static_cast<char>(value));
+        }
+
+        static auto broadcast(std::uint16_t value, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm256_set1_epi16(static_cast<short>(value));
+        }
+
+        static auto broadcast(std::uint32_t value, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm256_set1_epi32(static_cast<int>(value));
+        }
+
+        static auto broadcast(std::uint64_t value, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm256_set1_epi64x(static_cast<long long>(value));
+        }
+
+        static auto add(vector lhs, vector rhs, lane_width<1>) noexcept -> vector { return _mm256_add_epi8(lhs, rhs); }
+        static auto add(vector lhs, vector rhs, lane_width<2>) noexcept -> vector { return _mm256_add_epi16(lhs, rhs); }
+        static auto add(vector lhs, vector rhs, lane_width<4>) noexcept -> vector { return _mm256_add_epi32(lhs, rhs); }
+        static auto add(vector lhs, vector rhs, lane_width<8>) noexcept -> vector { return _mm256_add_epi64(lhs, rhs); }
+
+        static auto sub(vector lhs, vector rhs, lane_width<1>) noexcept -> vector { return _mm256_sub_epi8(lhs, rhs); }
+        static auto sub(vector lhs, vector rhs, lane_width<2>) noexcept -> vector { return _mm256_sub_epi16(lhs, rhs); }
+        static auto sub(vector lhs, vector rhs, lane_width<4>) noexcept -> vector { return _mm256_sub_epi32(lhs, rhs); }
+        static auto sub(vector lhs, vector rhs, lane_width<8>) noexcept -> vector { return _mm256_sub_epi64(lhs, rhs); }
+
+        static auto shift_right(vector v, int count, lane_width<1>) noexcept
+            -> vector
+        {
+            auto mask = _mm256_set1_epi8(static_cast<char>(0xff >> count));
+            return _mm256_and_si256(_mm256_srl_epi16(v, _mm_cvtsi32_si128(count)), mask);
+        }
+
+        static auto shift_right(vector v, int count, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm256_srl_epi16(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_right(vector v, int count, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm256_srl_epi32(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_right(vector v, int count, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm256_srl_epi64(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<1>) noexcept
+            -> vector
+        {
+            auto mask = _mm256_set1_epi8(static_cast<char>((0xff << count) & 0xff));
+            return _mm256_and_si256(_mm256_sll_epi16(v, _mm_cvtsi32_si128(count)), mask);
+        }
+
+        static auto shift_left(vector v, int count, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm256_sll_epi16(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm256_sll_epi32(v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm256_sll_epi64(v, _mm_cvtsi32_si128(count));
+        }
+    };
+#   if defined(CPPGRAY_SIMD_DISPATCH) && not defined(CPPGRAY_SIMD_AVX2)
+    CPPGRAY_SIMD_TARGET_POP
+#   endif
+#endif
+
+#if defined(CPPGRAY_SIMD_AVX512_OPS)
+#   if defined(CPPGRAY_SIMD_DISPATCH) && not defined(CPPGRAY_SIMD_AVX512BW)
+    CPPGRAY_SIMD_TARGET_PUSH_AVX512
+#   endif
+    // 8-bit and 16-bit lanes are only available with AVX-512BW;
+    // shifts use the zero-masking forms with a full mask because
+    // the unmasked ones trigger spurious -Wmaybe-uninitialized
+    // warnings with some versions of GCC
+    struct avx512_ops
+    {
+        using vector = __m512i;
+        static constexpr std::size_t size = 64;
+
+        static auto load(const void* ptr) noexcept
+            -> vector
+        {
+            return _mm512_loadu_si512(ptr);
+        }
+
+        static auto store(void* ptr, vector v) noexcept
+            -> void
+        {
+            _mm512_storeu_si512(ptr, v);
+        }
+
+        static auto bit_and(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm512_and_si512(lhs, rhs);
+        }
+
+        static auto bit_or(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm512_or_si512(lhs, rhs);
+        }
+
+        static auto bit_xor(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm512_xor_si512(lhs, rhs);
+        }
+
+        // lhs & ~rhs
+        static auto bit_andnot(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return _mm512_andnot_si512(rhs, lhs);
+        }
+
+        template<typename Unsigned>
+        static auto broadcast(Unsigned value) noexcept
+            -> vector
+        {
+            return broadcast(value, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto add(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return add(lhs, rhs, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto sub(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return sub(lhs, rhs, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto shift_right(vector v, int count) noexcept
+            -> vector
+        {
+            return shift_right(v, count, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto shift_left(vector v, int count) noexcept
+            -> vector
+        {
+            return shift_left(v, count, lane_width<sizeof(Unsigned)>{});
+        }
+
+        // Bitmask made of the most significant bit of every lane
+        template<typename Unsigned>
+        static auto msb_mask(vector v) noexcept
+            -> std::uint64_t
+        {
+            return msb_mask(v, lane_width<sizeof(Unsigned)>{});
+        }
+
+    private:
+
+        static auto msb_mask(vector v, lane_width<4>) noexcept
+            -> std::uint64_t
+        {
+            return _mm512_cmplt_epi32_mask(v, _mm512_setzero_si512());
+        }
+
+        static auto msb_mask(vector v, lane_width<8>) noexcept
+            -> std::uint64_t
+        {
+            return _mm512_cmplt_epi64_mask(v, _mm512_setzero_si512());
+        }
+
+        static auto broadcast(std::uint32_t value, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm512_set1_epi32(static_cast<int>(value));
+        }
+
+        static auto broadcast(std::uint64_t value, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm512_set1_epi64(static_cast<long long>(value));
+        }
+
+        static auto add(vector lhs, vector rhs, lane_width<4>) noexcept -> vector { return _mm512_add_epi32(lhs, rhs); }
+        static auto add(vector lhs, vector rhs, lane_width<8>) noexcept -> vector { return _mm512_add_epi64(lhs, rhs); }
+
+        static auto sub(vector lhs, vector rhs, lane_width<4>) noexcept -> vector { return _mm512_sub_epi32(lhs, rhs); }
+        static auto sub(vector lhs, vector rhs, lane_width<8>) noexcept -> vector { return _mm512_sub_epi64(lhs, rhs); }
+
+        static auto shift_right(vector v, int count, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm512_maskz_srl_epi32(static_cast<__mmask16>(-1), v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_right(vector v, int count, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm512_maskz_srl_epi64(static_cast<__mmask8>(-1), v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<4>) noexcept
+            -> vector
+        {
+            return _mm512_maskz_sll_epi32(static_cast<__mmask16>(-1), v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<8>) noexcept
+            -> vector
+        {
+            return _mm512_maskz_sll_epi64(static_cast<__mmask8>(-1), v, _mm_cvtsi32_si128(count));
+        }
+
+#   if defined(CPPGRAY_SIMD_AVX512BW_OPS)
+        static auto broadcast(std::uint8_t value, lane_width<1>) noexcept
+            -> vector
+        {
+            return _mm512_set1_epi8(static_cast<char>(value));
+        }
+
+        static auto broadcast(std::uint16_t value, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm512_set1_epi16(static_cast<short>(value));
+        }
+
+        static auto add(vector lhs, vector rhs, lane_width<1>) noexcept -> vector { return _mm512_add_epi8(lhs, rhs); }
+        static auto add(vector lhs, vector rhs, lane_width<2>) noexcept -> vector { return _mm512_add_epi16(lhs, rhs); }
+
+        static auto sub(vector lhs, vector rhs, lane_width<1>) noexcept -> vector { return _mm512_sub_epi8(lhs, rhs); }
+        static auto sub(vector lhs, vector rhs, lane_width<2>) noexcept -> vector { return _mm512_sub_epi16(lhs, rhs); }
+
+        static auto shift_right(vector v, int count, lane_width<1>) noexcept
+            -> vector
+        {
+            auto mask = _mm512_set1_epi8(static_cast<char>(0xff >> count));
+            return _mm512_and_si512(_mm512_maskz_srl_epi16(static_cast<__mmask32>(-1), v, _mm_cvtsi32_si128(count)), mask);
+        }
+
+        static auto shift_right(vector v, int count, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm512_maskz_srl_epi16(static_cast<__mmask32>(-1), v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto shift_left(vector v, int count, lane_width<1>) noexcept
+            -> vector
+        {
+            auto mask = _mm512_set1_epi8(static_cast<char>((0xff << count) & 0xff));
+            return _mm512_and_si512(_mm512_maskz_sll_epi16(static_cast<__mmask32>(-1), v, _mm_cvtsi32_si128(count)), mask);
+        }
+
+        static auto shift_left(vector v, int count, lane_width<2>) noexcept
+            -> vector
+        {
+            return _mm512_maskz_sll_epi16(static_cast<__mmask32>(-1), v, _mm_cvtsi32_si128(count));
+        }
+
+        static auto msb_mask(vector v, lane_width<1>) noexcept
+            -> std::uint64_t
+        {
+            return _mm512_movepi8_mask(v);
+        }
+
+        static auto msb_mask(vector v, lane_width<2>) noexcept
+            -> std::uint64_t
+        {
+            return _mm512_movepi16_mask(v);
+        }
+#   endif
+    };
+#   if defined(CPPGRAY_SIMD_DISPATCH) && not defined(CPPGRAY_SIMD_AVX512BW)
+    CPPGRAY_SIMD_TARGET_POP
+#   endif
+#endif
+
+#if defined(CPPGRAY_SIMD_NEON)
+    // Every lane type is handled through uint8x16_t and
+    // reinterpreted on the fly; NEON shifts only take a
+    // signed per-lane count, negative for right shifts
+    struct neon_ops
+    {
+        using vector = uint8x16_t;
+        static constexpr std::size_t size = 16;
+
+        static auto load(const void* ptr) noexcept
+            -> vector
+        {
+            return vld1q_u8(static_cast<const std::uint8_t*>(ptr));
+        }
+
+        static auto store(void* ptr, vector v) noexcept
+            -> void
+        {
+            vst1q_u8(static_cast<std::uint8_t*>(ptr), v);
+        }
+
+        static auto bit_and(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return vandq_u8(lhs, rhs);
+        }
+
+        static auto bit_or(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return vorrq_u8(lhs, rhs);
+        }
+
+        static auto bit_xor(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return veorq_u8(lhs, rhs);
+        }
+
+        // lhs & ~rhs
+        static auto bit_andnot(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return vbicq_u8(lhs, rhs);
+        }
+
+        template<typename Unsigned>
+        static auto broadcast(Unsigned value) noexcept
+            -> vector
+        {
+            return broadcast(value, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto add(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return add(lhs, rhs, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto sub(vector lhs, vector rhs) noexcept
+            -> vector
+        {
+            return sub(lhs, rhs, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto shift_right(vector v, int count) noexcept
+            -> vector
+        {
+            return shift(v, -count, lane_width<sizeof(Unsigned)>{});
+        }
+
+        template<typename Unsigned>
+        static auto shift_left(vector v, int count) noexcept
+            -> vector
+        {
+            return shift(v, count, lane_width<sizeof(Unsigned)>{});
+        }
+
+    private:
+
+        static auto broadcast(std::uint8_t value, lane_width<1>) noexcept
+            -> vector
+        {
+            return vdupq_n_u8(value);
+        }
+
+        static auto broadcast(std::uint16_t value, lane_width<2>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u16(vdupq_n_u16(value));
+        }
+
+        static auto broadcast(std::uint32_t value, lane_width<4>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u32(vdupq_n_u32(value));
+        }
+
+        static auto broadcast(std::uint64_t value, lane_width<8>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u64(vdupq_n_u64(value));
+        }
+
+        static auto add(vector lhs, vector rhs, lane_width<1>) noexcept
+            -> vector
+        {
+            return vaddq_u8(lhs, rhs);
+        }
+
+        static auto add(vector lhs, vector rhs, lane_width<2>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u16(vaddq_u16(vreinterpretq_u16_u8(lhs), vreinterpretq_u16_u8(rhs)));
+        }
+
+        static auto add(vector lhs, vector rhs, lane_width<4>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u32(vaddq_u32(vreinterpretq_u32_u8(lhs), vreinterpretq_u32_u8(rhs)));
+        }
+
+        static auto add(vector lhs, vector rhs, lane_width<8>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u64(vaddq_u64(vreinterpretq_u64_u8(lhs), vreinterpretq_u64_u8(rhs)));
+        }
+
+        static auto sub(vector lhs, vector rhs, lane_width<1>) noexcept
+            -> vector
+        {
+            return vsubq_u8(lhs, rhs);
+        }
+
+        static auto sub(vector lhs, vector rhs, lane_width<2>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u16(vsubq_u16(vreinterpretq_u16_u8(lhs), vreinterpretq_u16_u8(rhs)));
+        }
+
+        static auto sub(vector lhs, vector rhs, lane_width<4>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u32(vsubq_u32(vreinterpretq_u32_u8(lhs), vreinterpretq_u32_u8(rhs)));
+        }
+
+        static auto sub(vector lhs, vector rhs, lane_width<8>) noexcept
+            -> vector
+        {
+            return vreinterpretq_u8_u64(vsubq_u64(vreinterpretq_u64_u8(lhs), vreinterpretq_u64_u8(rhs)));
+        }
+
+        static auto shift(vector v, int count, lane_width<1>) noexcept
+            -> vector
+        {
+            return vshlq_u8(v, vdupq_n_s8(static_cast<std::int8_t>(count)));
+        }
+
+        static auto shift(vector v, int count, lane_width<2>) noexcept
+            -> vector
+        {
+            auto res = vshlq_u16(vreinterpretq_u16_u8(v), vdupq_n_s16(static_cast<std::int16_t>(count)));
+            return vreinterpretq_u8_u16(res);
+        }
+
+        static auto shift(vector v, int count, lane_width<4>) noexcept
+            -> vector
+        {
+            auto res = vshlq_u32(vreinterpretq_u32_u8(v), vdupq_n_s32(count));
+            return vreinterpretq_u8_u32(res);
+        }
+
+        static auto shift(vector v, int count, lane_width<8>) noexcept
+            -> vector
+        {
+            auto res = vshlq_u64(vreinterpretq_u64_u8(v), vdupq_n_s64(count));
+            return vreinterpretq_u8_u64(res);
+        }
+    };
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Best instruction set for a given lane type
+
+    template<typename Unsigned, std::size_t Width = sizeof(Unsigned)>
+    struct simd_ops_for
+    {
+#if defined(CPPGRAY_SIMD_AVX512BW)
+        using type = avx512_ops;
+#elif defined(CPPGRAY_SIMD_AVX512F)
+        using type = std::conditional_t<(Width >= 4), avx512_ops, avx2_ops>;
+#elif defined(CPPGRAY_SIMD_AVX2)
+        using type = avx2_ops;
+#elif defined(CPPGRAY_SIMD_SSE2)
+        using type = sse2_ops;
+#elif defined(CPPGRAY_SIMD_NEON)
+        using type = neon_ops;
+#else
+        using type = no_simd_ops;
+#endif
+    };
+
+    // Lanes wider than 64 bits are never vectorized
+    template<typename Unsigned>
+    struct simd_ops_for<Unsigned, 16>
+    {
+        using type = no_simd_ops;
+    };
+
+    template<typename Unsigned>
+    using simd_ops_for_t = typename simd_ops_for<Unsigned>::type;
+}}
+
+#endif // CPPGRAY_DETAIL_SIMD_H_
@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_DETAIL_TYPE_TRAITS_H_
+#define CPPGRAY_DETAIL_TYPE_TRAITS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "config.h"
+
+namespace cppgray
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Unsigned integer types accepted by gray_code
+    //
+    // Same as the standard traits, except that they also
+    // accept the 128-bit integers of the compiler when they
+    // exist, even in strict standard modes
+
+#if defined(CPPGRAY_HAS_INT128)
+    __extension__ typedef unsigned __int128 uint128_type;
+    __extension__ typedef __int128 int128_type;
+#endif
+
+    template<typename T>
+    struct is_unsigned_integer:
+        std::is_unsigned<T>
+    {};
+
+    template<typename T>
+    struct make_signed:
+        std::make_signed<T>
+    {};
+
+#if defined(CPPGRAY_HAS_INT128)
+    template<>
+    struct is_unsigned_integer<uint128_type>:
+        std::true_type
+    {};
+
+    template<>
+    struct make_signed<uint128_type>
+    {
+        using type = int128_type;
+    };
+#endif
+
+    template<typename T>
+    using make_signed_t = typename make_signed<T>::type;
+
+    ////////////////////////////////////////////////////////////
+    // Smallest standard unsigned type with at least Bits bits
+
+    template<std::size_t Bits>
+    using uint_least_t = std::conditional_t<(Bits <= 8), std::uint8_t,
+                         std::conditional_t<(Bits <= 16), std::uint16_t,
+                         std::conditional_t<(Bits <= 32), std::uint32_t,
+                                                          std::uint64_t>>>;
+}}
+
+#endif // CPPGRAY_DETAIL_TYPE_TRAITS_H_
@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_DEVICE_H_
+#define CPPGRAY_DEVICE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include "gray.h"
+#include "range.h"
+
+/*
+ * The scalar operations of gray.h and the ranges of range.h
+ * are marked with CPPGRAY_HOST_DEVICE, and can thus be used
+ * directly in CUDA and HIP kernels. This header additionally
+ * provides kernels for the bulk operations, which are only
+ * available when compiling with nvcc or hipcc. The kernels
+ * use grid-stride loops and work with any launch
+ * configuration; the launch functions pick one and enqueue
+ * the kernel on the given stream without synchronizing.
+ */
+
+#if defined(__CUDACC__) || defined(__HIPCC__)
+
+namespace cppgray
+{
+    namespace device
+    {
+#if defined(__HIPCC__)
+        using stream_type = hipStream_t;
+#else
+        using stream_type = cudaStream_t;
+#endif
+
+        ////////////////////////////////////////////////////////////
+        // Kernels
+
+        /**
+         * @brief Converts size unsigned integers to Gray codes.
+         */
+        template<typename Unsigned, std::size_t Bits>
+        __global__ auto encode_kernel(const Unsigned* in, gray_code<Unsigned, Bits>* out, std::size_t size)
+            -> void;
+
+        /**
+         * @brief Converts size Gray codes to unsigned integers.
+         */
+        template<typename Unsigned, std::size_t Bits>
+        __global__ auto decode_kernel(const gray_code<Unsigned, Bits>* in, Unsigned* out, std::size_t size)
+            -> void;
+
+        /**
+         * @brief Calls a function on a slice of a Gray sequence per thread.
+         *
+         * Positions [first, last) are cut into one contiguous slice
+         * per thread of the grid, and every thread calls func with
+         * its slice as a gray_range; threads past the end of the
+         * positions don't call it. The function typically starts
+         * from the first Gray code of the slice and then follows
+         * the flips given by for_each_gray_flip.
+         */
+        template<typename Unsigned, typename Function>
+        __global__ auto slice_kernel(std::uint64_t first, std::uint64_t last, Function func)
+            -> void;
+
+        ////////////////////////////////////////////////////////////
+        // Launch functions
+
+        /**
+         * @brief Converts size unsigned integers of device memory to Gray codes.
+         */
+        template<typename Unsigned, std::size_t Bits>
+        auto encode(const Unsigned* in, gray_code<Unsigned, Bits>* out, std::size_t size,
+                    stream_type stream = 0)
+            -> void;
+
+        /**
+         * @brief Converts size Gray codes of device memory to unsigned integers.
+         */
+        template<typename Unsigned, std::size_t Bits>
+        auto decode(const gray_code<Unsigned, Bits>* in, Unsigned* out, std::size_t size,
+                    stream_type stream = 0)
+            -> void;
+
+        /**
+         * @brief Calls a device function on slices of a range.
+         *
+         * Launches slice_kernel with enough threads for the slices
+         * to be about the grain size of the range, which should be
+         * large enough to amortize the full encode at the start of
+         * every slice. With CUDA, func is typically a __device__
+         * lambda, which requires --extended-lambda.
+         *
+         * @param range Range of Gray codes to cut
+         * @param func Device function called with every slice
+         */
+        template<typename Unsigned, typename Function>
+        auto for_each_slice(const gray_range<Unsigned>& range, Function func,
+                            stream_type stream = 0)
+            -> void;
+
+        #include "device.inl"
+    }
+}
+
+#endif
+
+#endif // CPPGRAY_DEVICE_H_
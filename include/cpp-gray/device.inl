@@ -0,0 +1,139 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Threads per block of the kernels launched by the
+    // library, and maximum number of blocks of a launch
+    constexpr unsigned block_size = 256;
+    constexpr std::uint64_t max_blocks = 65535;
+
+    inline auto grid_size(std::uint64_t threads) noexcept
+        -> unsigned
+    {
+        auto blocks = (threads + block_size - 1) / block_size;
+        if (blocks > max_blocks)
+        {
+            blocks = max_blocks;
+        }
+        return blocks ? static_cast<unsigned>(blocks) : 1u;
+    }
+
+    __device__ inline auto thread_index() noexcept
+        -> std::size_t
+    {
+        return static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    }
+
+    __device__ inline auto thread_count() noexcept
+        -> std::size_t
+    {
+        return static_cast<std::size_t>(gridDim.x) * blockDim.x;
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Kernels
+
+template<typename Unsigned, std::size_t Bits>
+__global__ auto encode_kernel(const Unsigned* in, gray_code<Unsigned, Bits>* out, std::size_t size)
+    -> void
+{
+    const auto stride = detail::thread_count();
+    for (auto i = detail::thread_index() ; i < size ; i += stride)
+    {
+        out[i] = gray_code<Unsigned, Bits>(in[i]);
+    }
+}
+
+template<typename Unsigned, std::size_t Bits>
+__global__ auto decode_kernel(const gray_code<Unsigned, Bits>* in, Unsigned* out, std::size_t size)
+    -> void
+{
+    const auto stride = detail::thread_count();
+    for (auto i = detail::thread_index() ; i < size ; i += stride)
+    {
+        out[i] = static_cast<Unsigned>(in[i]);
+    }
+}
+
+template<typename Unsigned, typename Function>
+__global__ auto slice_kernel(std::uint64_t first, std::uint64_t last, Function func)
+    -> void
+{
+    const std::uint64_t threads = detail::thread_count();
+    const std::uint64_t slice_size = (last - first + threads - 1) / threads;
+    const std::uint64_t begin = first + detail::thread_index() * slice_size;
+    if (begin < last)
+    {
+        const std::uint64_t end = last - begin < slice_size ? last : begin + slice_size;
+        func(gray_range<Unsigned>(begin, end));
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Launch functions
+
+template<typename Unsigned, std::size_t Bits>
+auto encode(const Unsigned* in, gray_code<Unsigned, Bits>* out, std::size_t size,
+            stream_type stream)
+    -> void
+{
+    if (size == 0)
+    {
+        return;
+    }
+    encode_kernel<Unsigned, Bits><<<detail::grid_size(size), detail::block_size, 0, stream>>>(in, out, size);
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto decode(const gray_code<Unsigned, Bits>* in, Unsigned* out, std::size_t size,
+            stream_type stream)
+    -> void
+{
+    if (size == 0)
+    {
+        return;
+    }
+    decode_kernel<Unsigned, Bits><<<detail::grid_size(size), detail::block_size, 0, stream>>>(in, out, size);
+}
+
+template<typename Unsigned, typename Function>
+auto for_each_slice(const gray_range<Unsigned>& range, Function func,
+                    stream_type stream)
+    -> void
+{
+    if (range.empty())
+    {
+        return;
+    }
+    const auto grain = range.grain_size() ? range.grain_size() : 1;
+    const auto slices = (range.size() + grain - 1) / grain;
+    slice_kernel<Unsigned><<<detail::grid_size(slices), detail::block_size, 0, stream>>>(
+        range.begin().position(), range.end().position(), func
+    );
+}
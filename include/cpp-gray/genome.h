@@ -0,0 +1,201 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_GENOME_H_
+#define CPPGRAY_GENOME_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "batch.h"
+#include "gray.h"
+
+namespace cppgray
+{
+    /**
+     * @brief Gray-coded field of a genome.
+     *
+     * A field of bits bits encodes 2^bits evenly spaced real
+     * numbers, from min for the Gray code of 0 to max for the
+     * Gray code of 2^bits - 1.
+     */
+    struct genome_field
+    {
+        // Number of bits of the field, from 1 to 64
+        std::size_t bits;
+
+        // Real numbers encoded by the smallest and greatest codes
+        double min;
+        double max;
+    };
+
+    /**
+     * @brief Converts genomes of Gray-coded fields to real numbers.
+     *
+     * A genome is a string of bits stored in 64-bit words, least
+     * significant word first, where the fields of the layout are
+     * packed one after the other from bit 0, without padding; a
+     * field may span two words. A population is a contiguous
+     * array of genomes of words() words each.
+     *
+     * The population is decoded to a structure of arrays: the
+     * values of field f for the count genomes are stored at
+     * out[f * count] to out[f * count + count - 1]. The genomes
+     * are converted chunk by chunk; for every field of a chunk,
+     * the fields are extracted into a small buffer, decoded with
+     * the SIMD functions of batch.h and scaled, while the chunk
+     * is still in cache. Encoding rounds every real number to the
+     * nearest code, the numbers outside [min, max] being clamped.
+     *
+     * genome_codec codec = { { 12, -5.0, 5.0 }, { 20, 0.0, 1.0 } };
+     * std::vector<std::uint64_t> population(codec.words() * count);
+     * std::vector<double> values(codec.fields() * count);
+     * codec.decode(population.data(), count, values.data());
+     */
+    class genome_codec
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using word_type = std::uint64_t;
+            using size_type = std::size_t;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            /**
+             * @brief Codec for the fields of the layout, in order.
+             */
+            genome_codec(std::initializer_list<genome_field> fields);
+
+            template<typename InputIterator>
+            genome_codec(InputIterator first, InputIterator last);
+
+            ////////////////////////////////////////////////////////////
+            // Layout
+
+            /**
+             * @brief Number of fields of a genome.
+             */
+            auto fields() const noexcept
+                -> size_type;
+
+            /**
+             * @brief Number of bits of a genome.
+             */
+            auto bits() const noexcept
+                -> size_type;
+
+            /**
+             * @brief Number of words of a genome.
+             */
+            auto words() const noexcept
+                -> size_type;
+
+            auto field(size_type index) const noexcept
+                -> genome_field;
+
+            ////////////////////////////////////////////////////////////
+            // Conversion operations
+
+            /**
+             * @brief Decodes a single field of a genome.
+             *
+             * @param genome Words of the genome
+             * @param index Index of the field
+             */
+            auto decode_field(const word_type* genome, size_type index) const noexcept
+                -> double;
+
+            /**
+             * @brief Decodes a population into a structure of arrays.
+             *
+             * @param genomes count * words() words of the genomes
+             * @param count Number of genomes
+             * @param out fields() * count real numbers, field-major
+             */
+            auto decode(const word_type* genomes, size_type count, double* out) const noexcept
+                -> void;
+
+            /**
+             * @brief Encodes a structure of arrays into a population.
+             *
+             * Every word of the genomes is overwritten, including
+             * the bits past the last field.
+             *
+             * @param in fields() * count real numbers, field-major
+             * @param count Number of genomes
+             * @param genomes count * words() words of the genomes
+             */
+            auto encode(const double* in, size_type count, word_type* genomes) const noexcept
+                -> void;
+
+        private:
+
+            // Layout of a field precomputed for the conversions
+            struct field_info
+            {
+                genome_field field;
+                size_type word;
+                unsigned shift;
+                bool spans_words;
+                word_type mask;
+                double scale;
+                double inverse_scale;
+                double limit;
+            };
+
+            auto add_field(const genome_field& field)
+                -> void;
+
+            auto extract(const field_info& info, const word_type* genome) const noexcept
+                -> word_type;
+
+            auto quantize(const field_info& info, double value) const noexcept
+                -> word_type;
+
+            template<typename Unsigned>
+            auto decode_chunk(const field_info& info, const word_type* genomes,
+                              size_type count, double* out) const noexcept
+                -> void;
+
+            template<typename Unsigned>
+            auto encode_chunk(const field_info& info, const double* in,
+                              size_type count, word_type* genomes) const noexcept
+                -> void;
+
+            std::vector<field_info> _fields;
+            size_type _bits;
+    };
+
+    #include "genome.inl"
+}
+
+#endif // CPPGRAY_GENOME_H_
@@ -0,0 +1,249 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Number of genomes converted at once, small enough for the
+    // genomes and the buffers to stay in the L1 cache
+    constexpr std::size_t genome_chunk_size = 256;
+}
+
+////////////////////////////////////////////////////////////
+// Construction
+
+inline genome_codec::genome_codec(std::initializer_list<genome_field> fields):
+    genome_codec(fields.begin(), fields.end())
+{}
+
+template<typename InputIterator>
+genome_codec::genome_codec(InputIterator first, InputIterator last):
+    _fields(),
+    _bits(0)
+{
+    for (; first != last ; ++first)
+    {
+        add_field(*first);
+    }
+}
+
+inline auto genome_codec::add_field(const genome_field& field)
+    -> void
+{
+    field_info info = {};
+    info.field = field;
+    info.word = _bits / 64;
+    info.shift = static_cast<unsigned>(_bits % 64);
+    info.spans_words = info.shift + field.bits > 64;
+    info.mask = ~word_type(0) >> (64 - field.bits);
+
+    // 2^bits - 1 steps between min and max
+    double steps = std::ldexp(1.0, static_cast<int>(field.bits)) - 1.0;
+    info.scale = (field.max - field.min) / steps;
+    info.inverse_scale = steps / (field.max - field.min);
+    info.limit = std::ldexp(1.0, static_cast<int>(field.bits));
+
+    _fields.push_back(info);
+    _bits += field.bits;
+}
+
+////////////////////////////////////////////////////////////
+// Layout
+
+inline auto genome_codec::fields() const noexcept
+    -> size_type
+{
+    return _fields.size();
+}
+
+inline auto genome_codec::bits() const noexcept
+    -> size_type
+{
+    return _bits;
+}
+
+inline auto genome_codec::words() const noexcept
+    -> size_type
+{
+    return (_bits + 63) / 64;
+}
+
+inline auto genome_codec::field(size_type index) const noexcept
+    -> genome_field
+{
+    return _fields[index].field;
+}
+
+////////////////////////////////////////////////////////////
+// Helper functions
+
+inline auto genome_codec::extract(const field_info& info, const word_type* genome) const noexcept
+    -> word_type
+{
+    const word_type* words = genome + info.word;
+    word_type res = words[0] >> info.shift;
+    if (info.spans_words)
+    {
+        res |= words[1] << (64 - info.shift);
+    }
+    return res & info.mask;
+}
+
+// Nearest code of a value, the comparisons being written so
+// that NaN gives 0 and that the conversion to an integer is
+// always within range
+inline auto genome_codec::quantize(const field_info& info, double value) const noexcept
+    -> word_type
+{
+    double pos = (value - info.field.min) * info.inverse_scale + 0.5;
+    if (not (pos > 0.0))
+    {
+        return 0;
+    }
+    if (pos >= info.limit)
+    {
+        return info.mask;
+    }
+    return static_cast<word_type>(pos);
+}
+
+template<typename Unsigned>
+auto genome_codec::decode_chunk(const field_info& info, const word_type* genomes,
+                                size_type count, double* out) const noexcept
+    -> void
+{
+    const size_type stride = words();
+    Unsigned codes[detail::genome_chunk_size] = {};
+    for (size_type i = 0 ; i < count ; ++i)
+    {
+        codes[i] = static_cast<Unsigned>(extract(info, genomes + i * stride));
+    }
+
+    // The upper bits of the codes are 0, so decoding them with
+    // every bit of the underlying type gives the same result
+    cppgray::decode(reinterpret_cast<const gray_code<Unsigned>*>(codes), codes, count);
+
+    for (size_type i = 0 ; i < count ; ++i)
+    {
+        out[i] = info.field.min + static_cast<double>(codes[i]) * info.scale;
+    }
+}
+
+template<typename Unsigned>
+auto genome_codec::encode_chunk(const field_info& info, const double* in,
+                                size_type count, word_type* genomes) const noexcept
+    -> void
+{
+    const size_type stride = words();
+    Unsigned codes[detail::genome_chunk_size] = {};
+    for (size_type i = 0 ; i < count ; ++i)
+    {
+        codes[i] = static_cast<Unsigned>(quantize(info, in[i]));
+    }
+
+    cppgray::encode(codes, reinterpret_cast<gray_code<Unsigned>*>(codes), count);
+
+    for (size_type i = 0 ; i < count ; ++i)
+    {
+        word_type* words = genomes + i * stride + info.word;
+        word_type code = codes[i];
+        words[0] |= code << info.shift;
+        if (info.spans_words)
+        {
+            words[1] |= code >> (64 - info.shift);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Conversion operations
+
+inline auto genome_codec::decode_field(const word_type* genome, size_type index) const noexcept
+    -> double
+{
+    const field_info& info = _fields[index];
+    gray_code<word_type> code;
+    code.value = extract(info, genome);
+    return info.field.min + static_cast<double>(static_cast<word_type>(code)) * info.scale;
+}
+
+inline auto genome_codec::decode(const word_type* genomes, size_type count, double* out) const noexcept
+    -> void
+{
+    const size_type stride = words();
+    for (size_type start = 0 ; start < count ; start += detail::genome_chunk_size)
+    {
+        size_type size = count - start < detail::genome_chunk_size ?
+                         count - start : detail::genome_chunk_size;
+
+        const word_type* chunk = genomes + start * stride;
+        for (size_type f = 0 ; f < _fields.size() ; ++f)
+        {
+            // Narrow fields fit twice as many codes in a vector
+            const field_info& info = _fields[f];
+            double* field_out = out + f * count + start;
+            if (info.field.bits <= 32)
+            {
+                decode_chunk<std::uint32_t>(info, chunk, size, field_out);
+            }
+            else
+            {
+                decode_chunk<std::uint64_t>(info, chunk, size, field_out);
+            }
+        }
+    }
+}
+
+inline auto genome_codec::encode(const double* in, size_type count, word_type* genomes) const noexcept
+    -> void
+{
+    const size_type stride = words();
+    for (size_type start = 0 ; start < count ; start += detail::genome_chunk_size)
+    {
+        size_type size = count - start < detail::genome_chunk_size ?
+                         count - start : detail::genome_chunk_size;
+
+        word_type* chunk = genomes + start * stride;
+        for (size_type i = 0 ; i < size * stride ; ++i)
+        {
+            chunk[i] = 0;
+        }
+
+        for (size_type f = 0 ; f < _fields.size() ; ++f)
+        {
+            const field_info& info = _fields[f];
+            const double* field_in = in + f * count + start;
+            if (info.field.bits <= 32)
+            {
+                encode_chunk<std::uint32_t>(info, field_in, size, chunk);
+            }
+            else
+            {
+                encode_chunk<std::uint64_t>(info, field_in, size, chunk);
+            }
+        }
+    }
+}
@@ -29,8 +29,14 @@
 ////////////////////////////////////////////////////////////
 #include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
+#include "detail/config.h"
+#include "detail/type_traits.h"
+#if defined(CPPGRAY_HAS_THREE_WAY_COMPARISON)
+#   include <compare>
+#endif
 
 namespace cppgray
 {
@@ -43,16 +49,39 @@ namespace cppgray
      * auto gr = gray_code<std::uint16_t>{ 24 };
      * std::uint16_t u = gr;        // u == 24 (0b11000)
      * std::uint16_t g = gr.value;  // g == 20 (0b10100)
+     *
+     * The number of bits of the Gray code can be lower than
+     * the number of bits of the underlying type, in which
+     * case the Gray code behaves like an unsigned integer of
+     * that number of bits: the upper bits of the underlying
+     * type are always 0, and the operations wrap around at
+     * 2^Bits.
+     *
+     * auto enc = gray_code<std::uint16_t, 12>{ 4095 };
+     * ++enc;                       // enc == 0
      */
-    template<typename Unsigned>
+    template<
+        typename Unsigned,
+        std::size_t Bits = std::numeric_limits<Unsigned>::digits
+    >
     struct gray_code
     {
-        static_assert(std::is_unsigned<Unsigned>::value,
+        static_assert(detail::is_unsigned_integer<Unsigned>::value,
                       "gray_code only supports built-in unsigned integers");
+        static_assert(Bits > 0 && Bits <= std::numeric_limits<Unsigned>::digits,
+                      "the number of bits must fit in the underlying type");
 
         // Underlying unsigned integer type
         using value_type = Unsigned;
 
+        // Number of bits of the Gray code
+        static constexpr std::size_t bits = Bits;
+
+        // Bits of the underlying type used by the Gray code
+        static constexpr value_type mask = static_cast<value_type>(
+            static_cast<value_type>(~value_type(0)) >> (std::numeric_limits<Unsigned>::digits - Bits)
+        );
+
         // Unsigned integer in Gray code
         value_type value;
 
@@ -60,7 +89,7 @@ namespace cppgray
         // Constructors operations
 
         // Default constructor
-        constexpr gray_code() noexcept;
+        CPPGRAY_HOST_DEVICE constexpr gray_code() noexcept;
 
         /**
          * @brief Construction from an unsigned integer.
@@ -70,7 +99,7 @@ namespace cppgray
          *
          * @param value Unsigned integer to convert
          */
-        constexpr explicit gray_code(value_type value) noexcept;
+        CPPGRAY_HOST_DEVICE constexpr explicit gray_code(value_type value) noexcept;
 
         /**
          * @brief Construction from a `bitset`.
@@ -82,7 +111,7 @@ namespace cppgray
          */
         template<
             std::size_t N,
-            typename = std::enable_if_t<(N >= std::numeric_limits<value_type>::digits)>
+            typename = std::enable_if_t<(N >= Bits)>
         >
         explicit gray_code(const std::bitset<N>& value) noexcept;
 
@@ -94,22 +123,22 @@ namespace cppgray
          * to the booleans false and true. Therefore, the
          * construction from a boolean is a no-op.
          */
-        constexpr explicit gray_code(bool b) noexcept;
+        CPPGRAY_HOST_DEVICE constexpr explicit gray_code(bool b) noexcept;
 
         ////////////////////////////////////////////////////////////
         // Assignment operations
 
-        constexpr auto operator=(value_type other) & noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator=(value_type other) & noexcept
             -> gray_code&;
 
         template<
             std::size_t N,
-            typename = std::enable_if_t<(N >= std::numeric_limits<value_type>::digits)>
+            typename = std::enable_if_t<(N >= Bits)>
         >
         auto operator=(std::bitset<N> other) & noexcept
             -> gray_code&;
 
-        constexpr auto operator=(bool other) & noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator=(bool other) & noexcept
             -> gray_code&;
 
         ////////////////////////////////////////////////////////////
@@ -118,7 +147,7 @@ namespace cppgray
         /**
          * @brief Conversion to the underlying type.
          */
-        constexpr explicit operator value_type() const noexcept;
+        CPPGRAY_HOST_DEVICE constexpr explicit operator value_type() const noexcept;
 
         /**
          * @brief Conversion to the exact underlying bit representation.
@@ -126,48 +155,76 @@ namespace cppgray
         template<std::size_t N>
         constexpr explicit operator std::bitset<N>() const noexcept;
 
-        constexpr explicit operator bool() const noexcept;
+        CPPGRAY_HOST_DEVICE constexpr explicit operator bool() const noexcept;
 
         ////////////////////////////////////////////////////////////
         // Increment/decrement operations
 
-        constexpr auto operator++() noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator++() noexcept
             -> gray_code&;
-        constexpr auto operator++(int) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator++(int) noexcept
             -> gray_code;
 
-        constexpr auto operator--() noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator--() noexcept
             -> gray_code&;
-        constexpr auto operator--(int) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator--(int) noexcept
             -> gray_code;
 
+        ////////////////////////////////////////////////////////////
+        // Arithmetic assignment operations
+
+        /**
+         * @brief Moves forward in the Gray sequence.
+         *
+         * The Gray code is moved n positions forward with the
+         * same modular semantics as the underlying type. The
+         * operation runs in constant time, no matter how far
+         * the Gray code is moved.
+         *
+         * @param n Number of positions to move forward
+         */
+        CPPGRAY_HOST_DEVICE constexpr auto operator+=(value_type n) noexcept
+            -> gray_code&;
+        CPPGRAY_HOST_DEVICE constexpr auto operator+=(gray_code other) noexcept
+            -> gray_code&;
+
+        /**
+         * @brief Moves backward in the Gray sequence.
+         *
+         * @param n Number of positions to move backward
+         */
+        CPPGRAY_HOST_DEVICE constexpr auto operator-=(value_type n) noexcept
+            -> gray_code&;
+        CPPGRAY_HOST_DEVICE constexpr auto operator-=(gray_code other) noexcept
+            -> gray_code&;
+
         ////////////////////////////////////////////////////////////
         // Bitwise assignment operations
 
-        constexpr auto operator&=(gray_code other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator&=(gray_code other) noexcept
             -> gray_code&;
-        constexpr auto operator&=(value_type other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator&=(value_type other) noexcept
             -> gray_code&;
-        constexpr auto operator&=(bool other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator&=(bool other) noexcept
             -> gray_code&;
 
-        constexpr auto operator|=(gray_code other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator|=(gray_code other) noexcept
             -> gray_code&;
-        constexpr auto operator|=(value_type other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator|=(value_type other) noexcept
             -> gray_code&;
-        constexpr auto operator|=(bool other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator|=(bool other) noexcept
             -> gray_code&;
 
-        constexpr auto operator^=(gray_code other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator^=(gray_code other) noexcept
             -> gray_code&;
-        constexpr auto operator^=(value_type other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator^=(value_type other) noexcept
             -> gray_code&;
-        constexpr auto operator^=(bool other) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator^=(bool other) noexcept
             -> gray_code&;
 
-        constexpr auto operator>>=(std::size_t pos) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator>>=(std::size_t pos) noexcept
             -> gray_code&;
-        constexpr auto operator<<=(std::size_t pos) noexcept
+        CPPGRAY_HOST_DEVICE constexpr auto operator<<=(std::size_t pos) noexcept
             -> gray_code&;
     };
 
@@ -180,118 +237,239 @@ namespace cppgray
      * @param value Unsigned integer to convert to gray code.
      */
     template<typename Unsigned>
-    constexpr auto gray(Unsigned value) noexcept
+    CPPGRAY_HOST_DEVICE constexpr auto gray(Unsigned value) noexcept
         -> gray_code<Unsigned>;
 
     ////////////////////////////////////////////////////////////
     // Comparison operations
 
-    template<typename Unsigned>
-    constexpr auto operator==(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator==(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
         -> bool;
-    template<typename Unsigned>
-    constexpr auto operator!=(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator!=(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
         -> bool;
 
-    template<typename Unsigned>
-    constexpr auto operator==(gray_code<Unsigned> lhs, Unsigned rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator==(gray_code<Unsigned, Bits> lhs, Unsigned rhs) noexcept
         -> bool;
-    template<typename Unsigned>
-    constexpr auto operator!=(gray_code<Unsigned> lhs, Unsigned rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator!=(gray_code<Unsigned, Bits> lhs, Unsigned rhs) noexcept
         -> bool;
 
-    template<typename Unsigned>
-    constexpr auto operator==(Unsigned lhs, gray_code<Unsigned> rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator==(Unsigned lhs, gray_code<Unsigned, Bits> rhs) noexcept
         -> bool;
-    template<typename Unsigned>
-    constexpr auto operator!=(Unsigned lhs, gray_code<Unsigned> rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator!=(Unsigned lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> bool;
+
+    /*
+     * Ordering comparisons follow the order of the numbers
+     * represented by the Gray codes, but don't decode them:
+     * the bits above the highest differing bit are the same
+     * in both codes, and the decoded value of that bit is the
+     * parity of the bits above it and itself, which is enough
+     * to know which code is the greatest.
+     */
+
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator<(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> bool;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator<=(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> bool;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator>(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> bool;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator>=(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
         -> bool;
 
+#if defined(CPPGRAY_HAS_THREE_WAY_COMPARISON)
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator<=>(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> std::strong_ordering;
+#endif
+
     ////////////////////////////////////////////////////////////
     // Bitwise operations
 
-    template<typename Unsigned>
-    constexpr auto operator&(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator&(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator|(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator|(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator^(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator^(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator~(gray_code<Unsigned> val) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator~(gray_code<Unsigned, Bits> val) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator>>(gray_code<Unsigned> val, std::size_t pos) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator>>(gray_code<Unsigned, Bits> val, std::size_t pos) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator<<(gray_code<Unsigned> val, std::size_t pos) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator<<(gray_code<Unsigned, Bits> val, std::size_t pos) noexcept
+        -> gray_code<Unsigned, Bits>;
 
     ////////////////////////////////////////////////////////////
     // Bitwise operations with bool
 
-    template<typename Unsigned>
-    constexpr auto operator&(gray_code<Unsigned> lhs, bool rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator&(gray_code<Unsigned, Bits> lhs, bool rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator&(bool lhs, gray_code<Unsigned> rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator&(bool lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator|(gray_code<Unsigned> lhs, bool rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator|(gray_code<Unsigned, Bits> lhs, bool rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator|(bool lhs, gray_code<Unsigned> rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator|(bool lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator^(gray_code<Unsigned> lhs, bool rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator^(gray_code<Unsigned, Bits> lhs, bool rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
-    template<typename Unsigned>
-    constexpr auto operator^(bool lhs, gray_code<Unsigned> rhs) noexcept
-        -> gray_code<Unsigned>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator^(bool lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
 
     ////////////////////////////////////////////////////////////
     // Bitwise assignment operations
 
-    template<typename Unsigned>
-    constexpr auto operator&=(Unsigned& lhs, gray_code<Unsigned> rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator&=(Unsigned& lhs, gray_code<Unsigned, Bits> rhs) noexcept
         -> Unsigned&;
 
-    template<typename Unsigned>
-    constexpr auto operator|=(Unsigned& lhs, gray_code<Unsigned> rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator|=(Unsigned& lhs, gray_code<Unsigned, Bits> rhs) noexcept
         -> Unsigned&;
 
-    template<typename Unsigned>
-    constexpr auto operator^=(Unsigned& lhs, gray_code<Unsigned> rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator^=(Unsigned& lhs, gray_code<Unsigned, Bits> rhs) noexcept
         -> Unsigned&;
 
+    ////////////////////////////////////////////////////////////
+    // Arithmetic operations
+    //
+    // Gray codes are added and subtracted according to the
+    // numbers they represent, with the modular semantics of
+    // the underlying type
+
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator+(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator+(gray_code<Unsigned, Bits> lhs, Unsigned rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator+(Unsigned lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
+
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator-(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto operator-(gray_code<Unsigned, Bits> lhs, Unsigned rhs) noexcept
+        -> gray_code<Unsigned, Bits>;
+
+    /**
+     * @brief Gray code following a given one in the Gray sequence.
+     *
+     * Same as incrementing a copy of the Gray code: the next
+     * Gray code differs by a single bit, and the last Gray code
+     * of the sequence is followed by 0. The bit to flip is
+     * computed without branches, which avoids mispredictions
+     * when stepping unrelated Gray codes.
+     */
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto successor(gray_code<Unsigned, Bits> code) noexcept
+        -> gray_code<Unsigned, Bits>;
+
+    /**
+     * @brief Gray code preceding a given one in the Gray sequence.
+     *
+     * Same as decrementing a copy of the Gray code, without
+     * branches either.
+     */
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto predecessor(gray_code<Unsigned, Bits> code) noexcept
+        -> gray_code<Unsigned, Bits>;
+
+    /**
+     * @brief Moves a Gray code by n positions in the Gray sequence.
+     *
+     * Negative values of n move the Gray code backward.
+     */
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto advance(gray_code<Unsigned, Bits>& code, detail::make_signed_t<Unsigned> n) noexcept
+        -> void;
+
+    /**
+     * @brief Number of positions between two Gray codes.
+     *
+     * Returns the number n such that advancing first by n
+     * positions gives last, wrapped to the signed type that
+     * corresponds to the underlying type.
+     */
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto distance(gray_code<Unsigned, Bits> first, gray_code<Unsigned, Bits> last) noexcept
+        -> detail::make_signed_t<Unsigned>;
+
     ////////////////////////////////////////////////////////////
     // Utility functions
 
-    template<typename Unsigned>
-    constexpr auto swap(gray_code<Unsigned>& lhs, gray_code<Unsigned>& rhs) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto swap(gray_code<Unsigned, Bits>& lhs, gray_code<Unsigned, Bits>& rhs) noexcept
         -> void;
 
     ////////////////////////////////////////////////////////////
     // Mathematical functions
 
-    template<typename Unsigned>
-    constexpr auto is_odd(gray_code<Unsigned> code) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto is_odd(gray_code<Unsigned, Bits> code) noexcept
         -> bool;
 
-    template<typename Unsigned>
-    constexpr auto is_even(gray_code<Unsigned> code) noexcept
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto is_even(gray_code<Unsigned, Bits> code) noexcept
+        -> bool;
+
+    ////////////////////////////////////////////////////////////
+    // Neighbourhood functions
+
+    /**
+     * @brief Number of bits that differ between two Gray codes.
+     */
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto hamming_distance(gray_code<Unsigned, Bits> lhs,
+                                                        gray_code<Unsigned, Bits> rhs) noexcept
+        -> std::size_t;
+
+    /**
+     * @brief Whether two Gray codes are consecutive in the Gray sequence.
+     *
+     * Adjacent Gray codes differ by a single bit, but the converse
+     * doesn't hold: 0b001 and 0b101 are the Gray codes of 1 and 6.
+     * The sequence wraps around, its last Gray code being adjacent
+     * to 0, and adjacency is symmetric: the function checks whether
+     * the bit that differs is the one flipped by incrementing or
+     * decrementing lhs.
+     */
+    template<typename Unsigned, std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto is_adjacent(gray_code<Unsigned, Bits> lhs,
+                                                   gray_code<Unsigned, Bits> rhs) noexcept
         -> bool;
 
     #include "gray.inl"
@@ -22,51 +22,356 @@
  * THE SOFTWARE.
  */
 
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Number of consecutive 0 bits starting from the least
+    // significant bit, 64 when the value is 0
+    CPPGRAY_HOST_DEVICE constexpr auto countr_zero(std::uint64_t value) noexcept
+        -> int
+    {
+        if (value == 0)
+        {
+            return 64;
+        }
+#if (defined(__GNUC__) || defined(__clang__)) && not defined(CPPGRAY_DEVICE_CODE)
+        return __builtin_ctzll(value);
+#else
+#   if defined(CPPGRAY_HAS_DEVICE_INTRINSICS)
+        if (not CPPGRAY_IS_CONSTANT_EVALUATED())
+        {
+            return __ffsll(static_cast<long long>(value)) - 1;
+        }
+#   endif
+        int res = 0;
+        while (not (value & 1))
+        {
+            value >>= 1;
+            ++res;
+        }
+        return res;
+#endif
+    }
+
+    // Isolates the highest bit set, 0 when the value is 0
+    template<typename Unsigned>
+    CPPGRAY_HOST_DEVICE constexpr auto highest_bit(Unsigned value) noexcept
+        -> Unsigned
+    {
+        if (value == 0)
+        {
+            return 0;
+        }
+#if (defined(__GNUC__) || defined(__clang__)) && not defined(CPPGRAY_DEVICE_CODE)
+        if (std::numeric_limits<Unsigned>::digits <= 64)
+        {
+            auto high = 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+            return static_cast<Unsigned>(Unsigned(1) << high);
+        }
+        if (std::numeric_limits<Unsigned>::digits == 128)
+        {
+            // Look at each 64-bit half separately, the shift is
+            // only ever 64 but must be valid for every type
+            constexpr int half = std::numeric_limits<Unsigned>::digits / 2;
+            auto upper = static_cast<unsigned long long>(value >> half);
+            if (upper)
+            {
+                return static_cast<Unsigned>(Unsigned(highest_bit(upper)) << half);
+            }
+            return highest_bit(static_cast<unsigned long long>(value));
+        }
+#elif defined(CPPGRAY_HAS_DEVICE_INTRINSICS)
+        if (std::numeric_limits<Unsigned>::digits <= 64 && not CPPGRAY_IS_CONSTANT_EVALUATED())
+        {
+            auto high = 63 - __clzll(static_cast<long long>(value));
+            return static_cast<Unsigned>(Unsigned(1) << high);
+        }
+#endif
+        // Smear the highest bit to the right then keep
+        // only the topmost one
+        for (int i = 1 ; i < std::numeric_limits<Unsigned>::digits ; i <<= 1)
+        {
+            value |= static_cast<Unsigned>(value >> i);
+        }
+        return static_cast<Unsigned>(value ^ (value >> 1));
+    }
+
+    // Parity of the number of bits set in an unsigned integer
+    template<typename Unsigned>
+    CPPGRAY_HOST_DEVICE constexpr auto parity(Unsigned value) noexcept
+        -> bool
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && not defined(CPPGRAY_DEVICE_CODE)
+        // Compiler intrinsics tend to be the fastest, but they
+        // take different types and must not truncate the value
+        if (std::numeric_limits<Unsigned>::digits > std::numeric_limits<unsigned long long>::digits)
+        {
+            constexpr int half = std::numeric_limits<Unsigned>::digits / 2;
+            return parity(static_cast<unsigned long long>(value ^ (value >> half)));
+        }
+        if (std::numeric_limits<Unsigned>::digits <= std::numeric_limits<unsigned>::digits)
+        {
+            return static_cast<bool>(__builtin_parity(static_cast<unsigned>(value)));
+        }
+        if (std::numeric_limits<Unsigned>::digits <= std::numeric_limits<unsigned long>::digits)
+        {
+            return static_cast<bool>(__builtin_parityl(static_cast<unsigned long>(value)));
+        }
+        return static_cast<bool>(__builtin_parityll(static_cast<unsigned long long>(value)));
+#else
+#   if defined(CPPGRAY_HAS_MSVC_POPCNT)
+        if (not CPPGRAY_IS_CONSTANT_EVALUATED())
+        {
+            return static_cast<bool>(__popcnt64(static_cast<unsigned __int64>(value)) & 1);
+        }
+#   elif defined(CPPGRAY_HAS_DEVICE_INTRINSICS)
+        if (std::numeric_limits<Unsigned>::digits <= 64 && not CPPGRAY_IS_CONSTANT_EVALUATED())
+        {
+            return static_cast<bool>(__popcll(static_cast<unsigned long long>(value)) & 1);
+        }
+#   endif
+        // Fold the value onto its lowest 4 bits, then use
+        // a 16-bit lookup table holding the parity of every
+        // 4-bit value
+        for (int i = std::numeric_limits<Unsigned>::digits / 2 ; i > 2 ; i >>= 1)
+        {
+            value ^= static_cast<Unsigned>(value >> i);
+        }
+        value &= 0xf;
+        return static_cast<bool>((0b0110'1001'1001'0110 >> value) & 1);
+#endif
+    }
+
+    // Number of bits set in an unsigned integer
+    template<typename Unsigned>
+    CPPGRAY_HOST_DEVICE constexpr auto popcount(Unsigned value) noexcept
+        -> int
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && not defined(CPPGRAY_DEVICE_CODE)
+        if (std::numeric_limits<Unsigned>::digits > std::numeric_limits<unsigned long long>::digits)
+        {
+            constexpr int half = std::numeric_limits<Unsigned>::digits / 2;
+            return popcount(static_cast<unsigned long long>(value >> half))
+                 + popcount(static_cast<unsigned long long>(value));
+        }
+        return __builtin_popcountll(static_cast<unsigned long long>(value));
+#else
+#   if defined(CPPGRAY_HAS_MSVC_POPCNT)
+        if (not CPPGRAY_IS_CONSTANT_EVALUATED())
+        {
+            return static_cast<int>(__popcnt64(static_cast<unsigned __int64>(value)));
+        }
+#   elif defined(CPPGRAY_HAS_DEVICE_INTRINSICS)
+        if (std::numeric_limits<Unsigned>::digits <= 64 && not CPPGRAY_IS_CONSTANT_EVALUATED())
+        {
+            return __popcll(static_cast<unsigned long long>(value));
+        }
+#   endif
+        // Clear the lowest set bit until there is none left
+        int res = 0;
+        for (; value ; ++res)
+        {
+            value = static_cast<Unsigned>(value & (value - 1u));
+        }
+        return res;
+#endif
+    }
+
+    // Lowest bits of a bitset as an unsigned integer without
+    // throwing: to_ullong throws when any bit beyond the 64th
+    // is set, so these are cleared first
+    template<typename Unsigned, std::size_t N>
+    auto bitset_low_bits(const std::bitset<N>& bits) noexcept
+        -> Unsigned
+    {
+        constexpr auto ullong_bits = std::numeric_limits<unsigned long long>::digits;
+        if (std::numeric_limits<Unsigned>::digits > ullong_bits && N > ullong_bits)
+        {
+            // Integers wider than unsigned long long are built
+            // from two halves
+            constexpr int half = std::numeric_limits<Unsigned>::digits / 2;
+            auto upper = bitset_low_bits<unsigned long long>(bits >> ullong_bits);
+            auto lower = bitset_low_bits<unsigned long long>(bits);
+            return static_cast<Unsigned>((static_cast<Unsigned>(upper) << half) | lower);
+        }
+        if (N > ullong_bits)
+        {
+            return static_cast<Unsigned>((bits & std::bitset<N>(~0ull)).to_ullong());
+        }
+        return static_cast<Unsigned>(bits.to_ullong());
+    }
+
+    // Bitset holding the bits of an unsigned integer, the
+    // bitset constructor only takes unsigned long long
+    template<std::size_t N, typename Unsigned>
+    auto to_bitset(Unsigned value) noexcept
+        -> std::bitset<N>
+    {
+        constexpr auto ullong_bits = std::numeric_limits<unsigned long long>::digits;
+        if (std::numeric_limits<Unsigned>::digits > ullong_bits && N > ullong_bits)
+        {
+            constexpr int half = std::numeric_limits<Unsigned>::digits / 2;
+            std::bitset<N> res(static_cast<unsigned long long>(value >> half));
+            res <<= ullong_bits;
+            return res | std::bitset<N>(static_cast<unsigned long long>(value));
+        }
+        return std::bitset<N>(static_cast<unsigned long long>(value));
+    }
+
+    // Incrementing a Gray code flips bit 0 when its parity is
+    // even, and the bit on the left of its lowest set bit
+    // otherwise, the most significant bit being flipped back
+    // to 0 on overflow; decrementing flips the same bits for
+    // the opposite parities, 0 wrapping around to the msb.
+    // Computing both candidates and selecting one of them
+    // with a mask avoids any branch
+    template<std::size_t Bits, typename Unsigned>
+    CPPGRAY_HOST_DEVICE constexpr auto upward_flip(Unsigned value) noexcept
+        -> Unsigned
+    {
+        constexpr Unsigned msb = Unsigned(1) << (Bits - 1);
+        constexpr Unsigned mask = gray_code<Unsigned, Bits>::mask;
+
+        auto low = static_cast<Unsigned>(value | msb);
+        auto y = static_cast<Unsigned>(low & static_cast<Unsigned>(Unsigned(0) - low));
+        return static_cast<Unsigned>((static_cast<Unsigned>(y << 1) & mask) | (y & msb));
+    }
+
+    template<std::size_t Bits, typename Unsigned>
+    CPPGRAY_HOST_DEVICE constexpr auto successor_flip(Unsigned value) noexcept
+        -> Unsigned
+    {
+        auto odd = static_cast<Unsigned>(Unsigned(0) - static_cast<Unsigned>(parity(value)));
+        auto up = upward_flip<Bits>(value);
+        return static_cast<Unsigned>(Unsigned(1) ^ ((up ^ Unsigned(1)) & odd));
+    }
+
+    template<std::size_t Bits, typename Unsigned>
+    CPPGRAY_HOST_DEVICE constexpr auto predecessor_flip(Unsigned value) noexcept
+        -> Unsigned
+    {
+        auto odd = static_cast<Unsigned>(Unsigned(0) - static_cast<Unsigned>(parity(value)));
+        auto up = upward_flip<Bits>(value);
+        return static_cast<Unsigned>(up ^ ((up ^ Unsigned(1)) & odd));
+    }
+
+    // Largest shift of the shift/xor decoding chain for a
+    // Gray code of the given number of bits, which is the
+    // largest power of 2 lower than that number of bits
+    CPPGRAY_HOST_DEVICE constexpr auto decode_shift(std::size_t bits) noexcept
+        -> std::size_t
+    {
+        std::size_t res = 1;
+        while (res * 2 < bits)
+        {
+            res *= 2;
+        }
+        return bits > 1 ? res : 0;
+    }
+
+#if defined(CPPGRAY_HAS_CLMUL)
+    // The decoded bit i of a Gray code is the xor of all the
+    // bits from i upwards: a carry-less multiplication by a
+    // number whose Bits lowest bits are set computes all of
+    // these xors at once, the decoded value being the bits
+    // Bits - 1 to 2 * Bits - 2 of the 128-bit product; only
+    // meant to be used for more than 32 bits
+    template<std::size_t Bits>
+    auto clmul_decode(std::uint64_t value) noexcept
+        -> std::uint64_t
+    {
+        constexpr std::uint64_t ones = ~std::uint64_t(0) >> (64 - Bits);
+
+#   if defined(__x86_64__)
+        __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(value)),
+                                            _mm_set1_epi64x(static_cast<long long>(ones)), 0x00);
+        auto low = static_cast<std::uint64_t>(_mm_cvtsi128_si64(prod));
+        auto high = static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(prod, prod)));
+#   else
+        uint64x2_t prod = vreinterpretq_u64_p128(vmull_p64(value, ones));
+        auto low = static_cast<std::uint64_t>(vgetq_lane_u64(prod, 0));
+        auto high = static_cast<std::uint64_t>(vgetq_lane_u64(prod, 1));
+#   endif
+        return (high << ((65 - Bits) % 64)) | (low >> (Bits - 1));
+    }
+#endif
+
+#if defined(CPPGRAY_HAS_INT128)
+    // Decodes a Gray code of more than 64 bits as two 64-bit
+    // halves: the lowest bit of the decoded upper half is the
+    // parity of its Gray code bits, which flips every bit of
+    // the lower half when it is set
+    template<std::size_t Bits>
+    CPPGRAY_HOST_DEVICE constexpr auto decode_halves(uint128_type value) noexcept
+        -> uint128_type
+    {
+        gray_code<std::uint64_t, Bits - 64> upper;
+        upper.value = static_cast<std::uint64_t>(value >> 64);
+        gray_code<std::uint64_t> lower;
+        lower.value = static_cast<std::uint64_t>(value);
+
+        auto high = static_cast<std::uint64_t>(upper);
+        auto low = static_cast<std::uint64_t>(lower) ^ (std::uint64_t(0) - (high & 1));
+        return (static_cast<uint128_type>(high) << 64) | low;
+    }
+#endif
+}
+
 ////////////////////////////////////////////////////////////
 // Construction operations
 
-template<typename Unsigned>
-constexpr gray_code<Unsigned>::gray_code() noexcept:
+template<typename Unsigned, std::size_t Bits>
+constexpr std::size_t gray_code<Unsigned, Bits>::bits;
+
+template<typename Unsigned, std::size_t Bits>
+constexpr Unsigned gray_code<Unsigned, Bits>::mask;
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr gray_code<Unsigned, Bits>::gray_code() noexcept:
     value(0)
 {}
 
-template<typename Unsigned>
-constexpr gray_code<Unsigned>::gray_code(value_type value) noexcept:
-    value( (value >> 1) ^ value )
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr gray_code<Unsigned, Bits>::gray_code(value_type value) noexcept:
+    value( ((value & mask) >> 1) ^ (value & mask) )
 {}
 
-template<typename Unsigned>
+template<typename Unsigned, std::size_t Bits>
 template<std::size_t N, typename>
-gray_code<Unsigned>::gray_code(const std::bitset<N>& value) noexcept:
-    value(value.to_ullong())
+gray_code<Unsigned, Bits>::gray_code(const std::bitset<N>& value) noexcept:
+    value(static_cast<value_type>(detail::bitset_low_bits<Unsigned>(value) & mask))
 {}
 
-template<typename Unsigned>
-constexpr gray_code<Unsigned>::gray_code(bool value) noexcept:
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr gray_code<Unsigned, Bits>::gray_code(bool value) noexcept:
     value(value)
 {}
 
 ////////////////////////////////////////////////////////////
 // Assignment operations
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator=(value_type other) & noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator=(value_type other) & noexcept
     -> gray_code&
 {
+    other &= mask;
     value = (other >> 1) ^ other;
     return *this;
 }
 
-template<typename Unsigned>
+template<typename Unsigned, std::size_t Bits>
 template<std::size_t N, typename>
-auto gray_code<Unsigned>::operator=(std::bitset<N> other) & noexcept
+auto gray_code<Unsigned, Bits>::operator=(std::bitset<N> other) & noexcept
     -> gray_code&
 {
-    value = other.to_ullong();
+    value = static_cast<value_type>(detail::bitset_low_bits<Unsigned>(other) & mask);
+    return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator=(bool other) & noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator=(bool other) & noexcept
     -> gray_code&
 {
     value = other;
@@ -76,27 +381,45 @@ constexpr auto gray_code<Unsigned>::operator=(bool other) & noexcept
 ////////////////////////////////////////////////////////////
 // Conversion operations
 
-template<typename Unsigned>
-constexpr gray_code<Unsigned>::operator value_type() const noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr gray_code<Unsigned, Bits>::operator value_type() const noexcept
 {
+#if defined(CPPGRAY_HAS_INT128)
+    if (Bits > 64)
+    {
+        constexpr std::size_t wide_bits = Bits > 64 ? Bits : 128;
+        return static_cast<value_type>(detail::decode_halves<wide_bits>(value));
+    }
+#endif
+
+#if defined(CPPGRAY_HAS_CLMUL)
+    // Only worth it when the shift/xor chain is long enough
+    if (Bits > 32 && Bits <= 64 && not CPPGRAY_IS_CONSTANT_EVALUATED())
+    {
+        constexpr std::size_t clmul_bits = Bits > 32 && Bits <= 64 ? Bits : 64;
+        return static_cast<value_type>(detail::clmul_decode<clmul_bits>(value));
+    }
+#endif
+
+    // The chain of shifts only needs to cover the bits
+    // actually used by the Gray code
     value_type res = value;
-    for (value_type mask = std::numeric_limits<value_type>::digits / 2
-         ; mask ; mask >>= 1)
+    for (std::size_t shift = detail::decode_shift(Bits) ; shift ; shift >>= 1)
     {
-        res ^= res >> mask;
+        res ^= res >> shift;
     }
     return res;
 }
 
-template<typename Unsigned>
+template<typename Unsigned, std::size_t Bits>
 template<std::size_t N>
-constexpr gray_code<Unsigned>::operator std::bitset<N>() const noexcept
+constexpr gray_code<Unsigned, Bits>::operator std::bitset<N>() const noexcept
 {
-    return value;
+    return detail::to_bitset<N>(value);
 }
 
-template<typename Unsigned>
-constexpr gray_code<Unsigned>::operator bool() const noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr gray_code<Unsigned, Bits>::operator bool() const noexcept
 {
     return static_cast<bool>(value);
 }
@@ -104,33 +427,16 @@ constexpr gray_code<Unsigned>::operator bool() const noexcept
 ////////////////////////////////////////////////////////////
 // Increment/decrement operations
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator++() noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator++() noexcept
     -> gray_code&
 {
-    constexpr value_type msb = 1 << (std::numeric_limits<value_type>::digits - 1);
-
-    if (is_odd(*this))
-    {
-        if (value == msb)
-        {
-            value = 0;
-        }
-        else
-        {
-            auto y = value & -value;
-            value ^= (y << 1);
-        }
-    }
-    else
-    {
-        value ^= 1;
-    }
+    value ^= detail::successor_flip<Bits>(value);
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator++(int) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator++(int) noexcept
     -> gray_code
 {
     auto res = *this;
@@ -138,33 +444,16 @@ constexpr auto gray_code<Unsigned>::operator++(int) noexcept
     return res;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator--() noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator--() noexcept
     -> gray_code&
 {
-    constexpr value_type msb = 1 << (std::numeric_limits<value_type>::digits - 1);
-
-    if (is_odd(*this))
-    {
-        value ^= 1;
-    }
-    else
-    {
-        if (value == 0)
-        {
-            value = msb;
-        }
-        else
-        {
-            auto y = value & -value;
-            value ^= (y << 1);
-        }
-    }
+    value ^= detail::predecessor_flip<Bits>(value);
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator--(int) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator--(int) noexcept
     -> gray_code
 {
     auto res = *this;
@@ -172,94 +461,128 @@ constexpr auto gray_code<Unsigned>::operator--(int) noexcept
     return res;
 }
 
+////////////////////////////////////////////////////////////
+// Arithmetic assignment operations
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator+=(value_type n) noexcept
+    -> gray_code&
+{
+    // There is no constant-time way to add Gray codes
+    // without decoding them, but decoding itself runs in
+    // constant time
+    return *this = static_cast<value_type>(static_cast<value_type>(*this) + n);
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator+=(gray_code other) noexcept
+    -> gray_code&
+{
+    return *this += static_cast<value_type>(other);
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator-=(value_type n) noexcept
+    -> gray_code&
+{
+    return *this = static_cast<value_type>(static_cast<value_type>(*this) - n);
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator-=(gray_code other) noexcept
+    -> gray_code&
+{
+    return *this -= static_cast<value_type>(other);
+}
+
 ////////////////////////////////////////////////////////////
 // Bitwise assignment operations
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator&=(gray_code other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator&=(gray_code other) noexcept
     -> gray_code&
 {
     value &= other.value;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator&=(value_type other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator&=(value_type other) noexcept
     -> gray_code&
 {
     value &= other;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator&=(bool other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator&=(bool other) noexcept
     -> gray_code&
 {
     value &= other;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator|=(gray_code other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator|=(gray_code other) noexcept
     -> gray_code&
 {
     value |= other.value;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator|=(value_type other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator|=(value_type other) noexcept
     -> gray_code&
 {
-    value |= other;
+    value |= other & mask;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator|=(bool other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator|=(bool other) noexcept
     -> gray_code&
 {
     value |= other;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator^=(gray_code other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator^=(gray_code other) noexcept
     -> gray_code&
 {
     value ^= other.value;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator^=(value_type other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator^=(value_type other) noexcept
     -> gray_code&
 {
-    value ^= other;
+    value ^= other & mask;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator^=(bool other) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator^=(bool other) noexcept
     -> gray_code&
 {
     value ^= other;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator>>=(std::size_t pos) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator>>=(std::size_t pos) noexcept
     -> gray_code&
 {
     value >>= pos;
     return *this;
 }
 
-template<typename Unsigned>
-constexpr auto gray_code<Unsigned>::operator<<=(std::size_t pos) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto gray_code<Unsigned, Bits>::operator<<=(std::size_t pos) noexcept
     -> gray_code&
 {
-    value <<= pos;
+    value = static_cast<value_type>(value << pos) & mask;
     return *this;
 }
 
@@ -267,7 +590,7 @@ constexpr auto gray_code<Unsigned>::operator<<=(std::size_t pos) noexcept
 // Construction function
 
 template<typename Unsigned>
-constexpr auto gray(Unsigned value) noexcept
+CPPGRAY_HOST_DEVICE constexpr auto gray(Unsigned value) noexcept
     -> gray_code<Unsigned>
 {
     return gray_code<Unsigned>(value);
@@ -276,90 +599,138 @@ constexpr auto gray(Unsigned value) noexcept
 ////////////////////////////////////////////////////////////
 // Comparison operations
 
-template<typename Unsigned>
-constexpr auto operator==(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator==(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
     -> bool
 {
     return lhs.value == rhs.value;
 }
 
-template<typename Unsigned>
-constexpr auto operator!=(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator!=(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
     -> bool
 {
     return lhs.value != rhs.value;
 }
 
-template<typename Unsigned>
-constexpr auto operator==(gray_code<Unsigned> lhs, Unsigned rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator==(gray_code<Unsigned, Bits> lhs, Unsigned rhs) noexcept
     -> bool
 {
-    return (rhs ^ (rhs >> 1)) == lhs.value;
+    return gray_code<Unsigned, Bits>(rhs).value == lhs.value;
 }
 
-template<typename Unsigned>
-constexpr auto operator!=(gray_code<Unsigned> lhs, Unsigned rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator!=(gray_code<Unsigned, Bits> lhs, Unsigned rhs) noexcept
     -> bool
 {
-    return (rhs ^ (rhs >> 1)) != lhs.value;
+    return gray_code<Unsigned, Bits>(rhs).value != lhs.value;
 }
 
-template<typename Unsigned>
-constexpr auto operator==(Unsigned lhs, gray_code<Unsigned> rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator==(Unsigned lhs, gray_code<Unsigned, Bits> rhs) noexcept
     -> bool
 {
-    return (lhs ^ (lhs >> 1)) == rhs.value;
+    return gray_code<Unsigned, Bits>(lhs).value == rhs.value;
 }
 
-template<typename Unsigned>
-constexpr auto operator!=(Unsigned lhs, gray_code<Unsigned> rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator!=(Unsigned lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> bool
+{
+    return gray_code<Unsigned, Bits>(lhs).value != rhs.value;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator<(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> bool
+{
+    auto high = detail::highest_bit(static_cast<Unsigned>(lhs.value ^ rhs.value));
+    if (high == 0)
+    {
+        return false;
+    }
+    // Decoded value of the highest differing bit in lhs
+    auto upper_bits = static_cast<Unsigned>(lhs.value & ~static_cast<Unsigned>(high - 1));
+    return not detail::parity(upper_bits);
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator<=(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
     -> bool
 {
-    return (lhs ^ (lhs >> 1)) != rhs.value;
+    return not (rhs < lhs);
 }
 
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator>(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> bool
+{
+    return rhs < lhs;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator>=(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> bool
+{
+    return not (lhs < rhs);
+}
+
+#if defined(CPPGRAY_HAS_THREE_WAY_COMPARISON)
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator<=>(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> std::strong_ordering
+{
+    if (lhs.value == rhs.value)
+    {
+        return std::strong_ordering::equal;
+    }
+    return lhs < rhs ? std::strong_ordering::less : std::strong_ordering::greater;
+}
+#endif
+
 ////////////////////////////////////////////////////////////
 // Bitwise operations
 
-template<typename Unsigned>
-constexpr auto operator&(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator&(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return lhs &= rhs;
 }
 
-template<typename Unsigned>
-constexpr auto operator|(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator|(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return lhs |= rhs;
 }
 
-template<typename Unsigned>
-constexpr auto operator^(gray_code<Unsigned> lhs, gray_code<Unsigned> rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator^(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return lhs ^= rhs;
 }
 
-template<typename Unsigned>
-constexpr auto operator~(gray_code<Unsigned> val) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator~(gray_code<Unsigned, Bits> val) noexcept
+    -> gray_code<Unsigned, Bits>
 {
-    val.value = ~val.value;
+    val.value = static_cast<Unsigned>(~val.value) & val.mask;
     return val;
 }
 
-template<typename Unsigned>
-constexpr auto operator>>(gray_code<Unsigned> val, std::size_t pos) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator>>(gray_code<Unsigned, Bits> val, std::size_t pos) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return val >>= pos;
 }
 
-template<typename Unsigned>
-constexpr auto operator<<(gray_code<Unsigned> val, std::size_t pos) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator<<(gray_code<Unsigned, Bits> val, std::size_t pos) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return val <<= pos;
 }
@@ -367,44 +738,44 @@ constexpr auto operator<<(gray_code<Unsigned> val, std::size_t pos) noexcept
 ////////////////////////////////////////////////////////////
 // Bitwise operations with bool
 
-template<typename Unsigned>
-constexpr auto operator&(gray_code<Unsigned> lhs, bool rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator&(gray_code<Unsigned, Bits> lhs, bool rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return lhs &= rhs;
 }
 
-template<typename Unsigned>
-constexpr auto operator&(bool lhs, gray_code<Unsigned> rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator&(bool lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return rhs &= lhs;
 }
 
-template<typename Unsigned>
-constexpr auto operator|(gray_code<Unsigned> lhs, bool rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator|(gray_code<Unsigned, Bits> lhs, bool rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return lhs |= rhs;
 }
 
-template<typename Unsigned>
-constexpr auto operator|(bool lhs, gray_code<Unsigned> rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator|(bool lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return rhs |= lhs;
 }
 
-template<typename Unsigned>
-constexpr auto operator^(gray_code<Unsigned> lhs, bool rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator^(gray_code<Unsigned, Bits> lhs, bool rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return lhs ^= rhs;
 }
 
-template<typename Unsigned>
-constexpr auto operator^(bool lhs, gray_code<Unsigned> rhs) noexcept
-    -> gray_code<Unsigned>
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator^(bool lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
 {
     return rhs ^= lhs;
 }
@@ -412,32 +783,112 @@ constexpr auto operator^(bool lhs, gray_code<Unsigned> rhs) noexcept
 ////////////////////////////////////////////////////////////
 // Bitwise assignment operations
 
-template<typename Unsigned>
-constexpr auto operator&=(Unsigned& lhs, gray_code<Unsigned> rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator&=(Unsigned& lhs, gray_code<Unsigned, Bits> rhs) noexcept
     -> Unsigned&
 {
     return lhs &= rhs.value;
 }
 
-template<typename Unsigned>
-constexpr auto operator|=(Unsigned& lhs, gray_code<Unsigned> rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator|=(Unsigned& lhs, gray_code<Unsigned, Bits> rhs) noexcept
     -> Unsigned&
 {
     return lhs |= rhs.value;
 }
 
-template<typename Unsigned>
-constexpr auto operator^=(Unsigned& lhs, gray_code<Unsigned> rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator^=(Unsigned& lhs, gray_code<Unsigned, Bits> rhs) noexcept
     -> Unsigned&
 {
     return lhs ^= rhs.value;
 }
 
+////////////////////////////////////////////////////////////
+// Arithmetic operations
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator+(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
+{
+    return lhs += rhs;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator+(gray_code<Unsigned, Bits> lhs, Unsigned rhs) noexcept
+    -> gray_code<Unsigned, Bits>
+{
+    return lhs += rhs;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator+(Unsigned lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
+{
+    return rhs += lhs;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator-(gray_code<Unsigned, Bits> lhs, gray_code<Unsigned, Bits> rhs) noexcept
+    -> gray_code<Unsigned, Bits>
+{
+    return lhs -= rhs;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto operator-(gray_code<Unsigned, Bits> lhs, Unsigned rhs) noexcept
+    -> gray_code<Unsigned, Bits>
+{
+    return lhs -= rhs;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto successor(gray_code<Unsigned, Bits> code) noexcept
+    -> gray_code<Unsigned, Bits>
+{
+    code.value ^= detail::successor_flip<Bits>(code.value);
+    return code;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto predecessor(gray_code<Unsigned, Bits> code) noexcept
+    -> gray_code<Unsigned, Bits>
+{
+    code.value ^= detail::predecessor_flip<Bits>(code.value);
+    return code;
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto advance(gray_code<Unsigned, Bits>& code, detail::make_signed_t<Unsigned> n) noexcept
+    -> void
+{
+    // Conversion to unsigned is modular, which is exactly
+    // what is needed to move backward
+    code += static_cast<Unsigned>(n);
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto distance(gray_code<Unsigned, Bits> first, gray_code<Unsigned, Bits> last) noexcept
+    -> detail::make_signed_t<Unsigned>
+{
+    constexpr Unsigned mask = gray_code<Unsigned, Bits>::mask;
+    constexpr Unsigned msb = Unsigned(1) << (Bits - 1);
+
+    auto diff = static_cast<Unsigned>(static_cast<Unsigned>(last) - static_cast<Unsigned>(first));
+    diff &= mask;
+    if (diff & msb)
+    {
+        // Sign-extend the difference to the underlying type
+        diff |= static_cast<Unsigned>(~mask);
+    }
+    return static_cast<detail::make_signed_t<Unsigned>>(diff);
+}
+
 ////////////////////////////////////////////////////////////
 // Utility functions
 
-template<typename Unsigned>
-constexpr auto swap(gray_code<Unsigned>& lhs, gray_code<Unsigned>& rhs) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto swap(gray_code<Unsigned, Bits>& lhs, gray_code<Unsigned, Bits>& rhs) noexcept
     -> void
 {
     auto tmp = lhs.value;
@@ -448,32 +899,39 @@ constexpr auto swap(gray_code<Unsigned>& lhs, gray_code<Unsigned>& rhs) noexcept
 ////////////////////////////////////////////////////////////
 // Mathematical functions
 
-template<typename Unsigned>
-constexpr auto is_odd(gray_code<Unsigned> code) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto is_odd(gray_code<Unsigned, Bits> code) noexcept
     -> bool
 {
     // A Gray code is odd when the number of bits set in
     // its representation is odd
-
-#if defined(__GNUC__) || defined(__clang__)
-    // Compiler intrinsics tend to be the fastest
-    return static_cast<bool>(__builtin_parity(code.value));
-#else
-    for (std::size_t i = std::numeric_limits<Unsigned>::digits / 2 ;
-         i > 2 ; i >>= 1)
-    {
-        code.value ^= (code.value >> i);
-    }
-    code.value &= 0xf;
-    return static_cast<bool>(
-        (0b0110'1001'1001'0110 >> code.value) & 1
-    );
-#endif
+    return detail::parity(code.value);
 }
 
-template<typename Unsigned>
-constexpr auto is_even(gray_code<Unsigned> code) noexcept
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto is_even(gray_code<Unsigned, Bits> code) noexcept
     -> bool
 {
     return not is_odd(code);
 }
+
+////////////////////////////////////////////////////////////
+// Neighbourhood functions
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto hamming_distance(gray_code<Unsigned, Bits> lhs,
+                                                    gray_code<Unsigned, Bits> rhs) noexcept
+    -> std::size_t
+{
+    return static_cast<std::size_t>(detail::popcount(static_cast<Unsigned>(lhs.value ^ rhs.value)));
+}
+
+template<typename Unsigned, std::size_t Bits>
+CPPGRAY_HOST_DEVICE constexpr auto is_adjacent(gray_code<Unsigned, Bits> lhs,
+                                               gray_code<Unsigned, Bits> rhs) noexcept
+    -> bool
+{
+    auto diff = static_cast<Unsigned>(lhs.value ^ rhs.value);
+    return diff == detail::successor_flip<Bits>(lhs.value) ||
+           diff == detail::predecessor_flip<Bits>(lhs.value);
+}
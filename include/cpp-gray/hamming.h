@@ -0,0 +1,156 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_HAMMING_H_
+#define CPPGRAY_HAMMING_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "combination.h"
+#include "gray.h"
+
+namespace cppgray
+{
+    /**
+     * @brief Index of Gray codes answering Hamming radius queries.
+     *
+     * Multi-index hashing: the bits of the Gray codes are cut into
+     * m contiguous chunks, and every chunk has a table of the codes
+     * sorted by the value of their chunk. When a code is within
+     * distance r of a query, at least one of its chunks is within
+     * distance r / m of the matching chunk of the query. A query
+     * thus looks up every value at most r / m bits away from each
+     * chunk of the query, enumerated with revolving_door_range,
+     * then checks the full distance of the candidates. A candidate
+     * found in several chunks is only reported for the first one.
+     *
+     * The tables take m * size entries of the underlying type and
+     * a 32-bit index. The default number of chunks, Bits / log2(size),
+     * makes every chunk value match about one code on average,
+     * which works well for small radiuses; lookups get more
+     * expensive as r / m grows.
+     *
+     * hamming_index<std::uint32_t> index(codes.data(), codes.size());
+     * index.for_each_within(query, 3, [&](std::size_t i) {
+     *     // hamming_distance(query, codes[i]) <= 3
+     * });
+     */
+    template<typename Unsigned, std::size_t Bits = std::numeric_limits<Unsigned>::digits>
+    class hamming_index
+    {
+        static_assert(Bits <= 64, "Hamming indices only support Gray codes of up to 64 bits");
+
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using code_type = gray_code<Unsigned, Bits>;
+            using size_type = std::size_t;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            /**
+             * @brief Index of a copy of the given Gray codes.
+             *
+             * @param codes Gray codes to index, fewer than 2^32 of them
+             * @param size Number of Gray codes
+             * @param chunks Number of chunks from 1 to Bits, or 0 to
+             *        pick it from the number of codes
+             */
+            hamming_index(const code_type* codes, size_type size, size_type chunks = 0);
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            /**
+             * @brief Number of indexed Gray codes.
+             */
+            auto size() const noexcept
+                -> size_type;
+
+            /**
+             * @brief Number of chunks of the Gray codes.
+             */
+            auto chunks() const noexcept
+                -> size_type;
+
+            /**
+             * @brief Indexed Gray code at a given position.
+             */
+            auto operator[](size_type index) const noexcept
+                -> code_type;
+
+            ////////////////////////////////////////////////////////////
+            // Queries
+
+            /**
+             * @brief Calls a function for every Gray code close to a query.
+             *
+             * func is called once with the position of every indexed
+             * Gray code whose Hamming distance to the query is at
+             * most radius, in no particular order. Large radii for
+             * which probing the chunk tables would cost more than
+             * scanning every code fall back to a linear scan.
+             *
+             * @return func
+             */
+            template<typename Function>
+            auto for_each_within(code_type query, size_type radius, Function func) const
+                -> Function;
+
+            /**
+             * @brief Positions of the Gray codes close to a query, sorted.
+             */
+            auto find_within(code_type query, size_type radius) const
+                -> std::vector<size_type>;
+
+        private:
+
+            struct entry
+            {
+                Unsigned key;
+                std::uint32_t index;
+            };
+
+            // Entries of every chunk sorted by key then index,
+            // the table of chunk c starting at c * size()
+            std::vector<entry> _entries;
+            std::vector<code_type> _codes;
+
+            // Bits of the Gray codes and offset of every chunk
+            std::vector<Unsigned> _masks;
+            std::vector<unsigned> _shifts;
+    };
+
+    #include "hamming.inl"
+}
+
+#endif // CPPGRAY_HAMMING_H_
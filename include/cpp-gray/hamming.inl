@@ -0,0 +1,208 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Number of chunks of multi-index hashing, chosen so that
+    // the chunks have about log2(size) bits
+    inline auto default_chunks(std::size_t bits, std::size_t size) noexcept
+        -> std::size_t
+    {
+        std::size_t log2 = 0;
+        while (log2 < 64 && (std::uint64_t(1) << log2) < size)
+        {
+            ++log2;
+        }
+        if (log2 == 0)
+        {
+            return 1;
+        }
+        auto res = (bits + log2 / 2) / log2;
+        return res ? (res < bits ? res : bits) : 1;
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Construction
+
+template<typename Unsigned, std::size_t Bits>
+hamming_index<Unsigned, Bits>::hamming_index(const code_type* codes, size_type size, size_type chunks):
+    _entries(),
+    _codes(codes, codes + size),
+    _masks(),
+    _shifts()
+{
+    if (chunks == 0)
+    {
+        chunks = detail::default_chunks(Bits, size);
+    }
+    if (chunks > Bits)
+    {
+        chunks = Bits;
+    }
+
+    // Chunks of nearly equal sizes, the first ones taking
+    // the remaining bits
+    unsigned shift = 0;
+    for (size_type c = 0 ; c < chunks ; ++c)
+    {
+        auto width = static_cast<unsigned>(Bits / chunks + (c < Bits % chunks ? 1 : 0));
+        auto ones = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1u;
+        _masks.push_back(static_cast<Unsigned>(ones << shift));
+        _shifts.push_back(shift);
+        shift += width;
+    }
+
+    _entries.reserve(chunks * size);
+    for (size_type c = 0 ; c < chunks ; ++c)
+    {
+        for (size_type i = 0 ; i < size ; ++i)
+        {
+            _entries.push_back({ static_cast<Unsigned>(codes[i].value & _masks[c]),
+                                 static_cast<std::uint32_t>(i) });
+        }
+        std::sort(_entries.begin() + c * size, _entries.end(),
+                  [](const entry& lhs, const entry& rhs) {
+                      return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.index < rhs.index);
+                  });
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Observers
+
+template<typename Unsigned, std::size_t Bits>
+auto hamming_index<Unsigned, Bits>::size() const noexcept
+    -> size_type
+{
+    return _codes.size();
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto hamming_index<Unsigned, Bits>::chunks() const noexcept
+    -> size_type
+{
+    return _masks.size();
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto hamming_index<Unsigned, Bits>::operator[](size_type index) const noexcept
+    -> code_type
+{
+    return _codes[index];
+}
+
+////////////////////////////////////////////////////////////
+// Queries
+
+template<typename Unsigned, std::size_t Bits>
+template<typename Function>
+auto hamming_index<Unsigned, Bits>::for_each_within(code_type query, size_type radius, Function func) const
+    -> Function
+{
+    // Every indexed code matches past Bits
+    if (radius > Bits)
+    {
+        radius = Bits;
+    }
+
+    const size_type chunks = _masks.size();
+    const size_type chunk_radius = radius / chunks;
+    const auto by_key = [](const entry& lhs, Unsigned key) { return lhs.key < key; };
+
+    // Probing costs as much as a linear scan once the number
+    // of probes reaches the number of codes; the count saturates
+    // since the probes of a 64-bit chunk can add up to 2^64
+    constexpr auto max_probes = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t probes = 0;
+    for (size_type c = 0 ; c < chunks && probes < size() ; ++c)
+    {
+        const auto width = static_cast<std::size_t>(detail::popcount(_masks[c]));
+        for (size_type d = 0 ; d <= chunk_radius && d <= width ; ++d)
+        {
+            auto ways = detail::binomial(width, d);
+            probes = ways < max_probes - probes ? probes + ways : max_probes;
+        }
+    }
+    if (probes >= size())
+    {
+        for (size_type i = 0 ; i < size() ; ++i)
+        {
+            auto diff = static_cast<Unsigned>(_codes[i].value ^ query.value);
+            if (static_cast<size_type>(detail::popcount(diff)) <= radius)
+            {
+                func(i);
+            }
+        }
+        return func;
+    }
+
+    for (size_type c = 0 ; c < chunks ; ++c)
+    {
+        const auto first = _entries.begin() + c * size();
+        const auto last = first + size();
+        const auto key = static_cast<Unsigned>(query.value & _masks[c]);
+        const auto width = static_cast<std::size_t>(detail::popcount(_masks[c]));
+
+        for (size_type d = 0 ; d <= chunk_radius && d <= width ; ++d)
+        {
+            for (auto flips: revolving_door_range<std::uint64_t>(width, d))
+            {
+                auto probe = static_cast<Unsigned>(key ^ (flips.value << _shifts[c]));
+                for (auto it = std::lower_bound(first, last, probe, by_key)
+                     ; it != last && it->key == probe ; ++it)
+                {
+                    // Skip the codes already found with a previous chunk
+                    auto diff = static_cast<Unsigned>(_codes[it->index].value ^ query.value);
+                    bool seen = false;
+                    for (size_type prev = 0 ; prev < c && not seen ; ++prev)
+                    {
+                        auto bits = static_cast<Unsigned>(diff & _masks[prev]);
+                        seen = static_cast<size_type>(detail::popcount(bits)) <= chunk_radius;
+                    }
+                    if (not seen && static_cast<size_type>(detail::popcount(diff)) <= radius)
+                    {
+                        func(static_cast<size_type>(it->index));
+                    }
+                }
+            }
+        }
+    }
+    return func;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto hamming_index<Unsigned, Bits>::find_within(code_type query, size_type radius) const
+    -> std::vector<size_type>
+{
+    std::vector<size_type> res;
+    for_each_within(query, radius, [&res](size_type index) {
+        res.push_back(index);
+    });
+    std::sort(res.begin(), res.end());
+    return res;
+}
@@ -0,0 +1,188 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_HILBERT_H_
+#define CPPGRAY_HILBERT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "gray.h"
+#include "detail/config.h"
+
+namespace cppgray
+{
+    /*
+     * Morton and Hilbert keys map 2D or 3D coordinates to a
+     * single std::uint32_t or std::uint64_t key such that
+     * points close in space tend to have close keys. Every
+     * coordinate gets the number of bits of the key divided
+     * by the number of dimensions: 16 or 32 bits in 2D, 10
+     * or 21 bits in 3D. The upper bits of the coordinates
+     * are ignored.
+     *
+     * A Morton key interleaves the bits of the coordinates,
+     * the bit of x being the least significant one of every
+     * group. The interleaving uses the BMI2 instructions PDEP
+     * and PEXT when they are available.
+     *
+     * A Hilbert key is the position of the point along the
+     * Hilbert curve, whose consecutive points are always
+     * neighbours. It is computed with John Skilling's method
+     * from Programming the Hilbert curve: the coordinates are
+     * transformed level by level, then interleaved, and the
+     * interleaved word is the Gray code of the key.
+     *
+     * auto key = hilbert_encode<std::uint32_t>(3u, 5u);
+     * auto pos = hilbert_decode<2>(key);  // { 3, 5 }
+     */
+
+    ////////////////////////////////////////////////////////////
+    // Morton keys
+
+    /**
+     * @brief Interleaves the bits of 2D coordinates.
+     *
+     * @param x First coordinate, in the least significant bits
+     * @param y Second coordinate
+     * @return Morton key of type Key
+     */
+    template<typename Key>
+    constexpr auto morton_encode(std::uint32_t x, std::uint32_t y) noexcept
+        -> Key;
+
+    /**
+     * @brief Interleaves the bits of 3D coordinates.
+     *
+     * @param x First coordinate, in the least significant bits
+     * @param y Second coordinate
+     * @param z Third coordinate
+     * @return Morton key of type Key
+     */
+    template<typename Key>
+    constexpr auto morton_encode(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept
+        -> Key;
+
+    /**
+     * @brief Splits a Morton key into its coordinates.
+     *
+     * @param key Morton key of Dims coordinates
+     * @return Coordinates, x first
+     */
+    template<std::size_t Dims, typename Key>
+    constexpr auto morton_decode(Key key) noexcept
+        -> std::array<std::uint32_t, Dims>;
+
+    ////////////////////////////////////////////////////////////
+    // Hilbert keys
+
+    /**
+     * @brief Position of 2D coordinates along the Hilbert curve.
+     *
+     * @param x First coordinate
+     * @param y Second coordinate
+     * @return Hilbert key of type Key
+     */
+    template<typename Key>
+    constexpr auto hilbert_encode(std::uint32_t x, std::uint32_t y) noexcept
+        -> Key;
+
+    /**
+     * @brief Position of 3D coordinates along the Hilbert curve.
+     *
+     * @param x First coordinate
+     * @param y Second coordinate
+     * @param z Third coordinate
+     * @return Hilbert key of type Key
+     */
+    template<typename Key>
+    constexpr auto hilbert_encode(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept
+        -> Key;
+
+    /**
+     * @brief Coordinates of a position along the Hilbert curve.
+     *
+     * @param key Hilbert key of Dims coordinates
+     * @return Coordinates, x first
+     */
+    template<std::size_t Dims, typename Key>
+    constexpr auto hilbert_decode(Key key) noexcept
+        -> std::array<std::uint32_t, Dims>;
+
+    ////////////////////////////////////////////////////////////
+    // Batch operations
+    //
+    // The coordinates live in one buffer per dimension and
+    // every point is converted independently; the loops are
+    // branchless so that the compiler can vectorize them
+
+    template<typename Key>
+    auto morton_encode(const std::uint32_t* x, const std::uint32_t* y,
+                       Key* out, std::size_t size) noexcept
+        -> void;
+
+    template<typename Key>
+    auto morton_encode(const std::uint32_t* x, const std::uint32_t* y, const std::uint32_t* z,
+                       Key* out, std::size_t size) noexcept
+        -> void;
+
+    template<typename Key>
+    auto morton_decode(const Key* in, std::uint32_t* x, std::uint32_t* y,
+                       std::size_t size) noexcept
+        -> void;
+
+    template<typename Key>
+    auto morton_decode(const Key* in, std::uint32_t* x, std::uint32_t* y, std::uint32_t* z,
+                       std::size_t size) noexcept
+        -> void;
+
+    template<typename Key>
+    auto hilbert_encode(const std::uint32_t* x, const std::uint32_t* y,
+                        Key* out, std::size_t size) noexcept
+        -> void;
+
+    template<typename Key>
+    auto hilbert_encode(const std::uint32_t* x, const std::uint32_t* y, const std::uint32_t* z,
+                        Key* out, std::size_t size) noexcept
+        -> void;
+
+    template<typename Key>
+    auto hilbert_decode(const Key* in, std::uint32_t* x, std::uint32_t* y,
+                        std::size_t size) noexcept
+        -> void;
+
+    template<typename Key>
+    auto hilbert_decode(const Key* in, std::uint32_t* x, std::uint32_t* y, std::uint32_t* z,
+                        std::size_t size) noexcept
+        -> void;
+
+    #include "hilbert.inl"
+}
+
+#endif // CPPGRAY_HILBERT_H_
@@ -0,0 +1,415 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    template<typename Key>
+    struct is_curve_key:
+        std::integral_constant<
+            bool,
+            std::is_same<Key, std::uint32_t>::value ||
+            std::is_same<Key, std::uint64_t>::value
+        >
+    {};
+
+    // Number of bits of every coordinate in a key
+    template<typename Key, std::size_t Dims>
+    constexpr auto curve_bits() noexcept
+        -> std::size_t
+    {
+        return std::numeric_limits<Key>::digits / Dims;
+    }
+
+    // Bits of a 64-bit key belonging to the coordinate
+    // stored in the least significant bit of every group
+    template<std::size_t Dims>
+    constexpr auto spread_mask() noexcept
+        -> std::uint64_t
+    {
+        return Dims == 2 ? 0x5555555555555555u : 0x1249249249249249u;
+    }
+
+    // Moves the bit i of value to the bit i * Dims
+    template<std::size_t Dims>
+    constexpr auto spread(std::uint64_t value) noexcept
+        -> std::uint64_t
+    {
+#if defined(CPPGRAY_HAS_BMI2)
+        if (not CPPGRAY_IS_CONSTANT_EVALUATED())
+        {
+            return static_cast<std::uint64_t>(_pdep_u64(value, spread_mask<Dims>()));
+        }
+#endif
+        if (Dims == 2)
+        {
+            value &= 0x00000000ffffffffu;
+            value = (value | value << 16) & 0x0000ffff0000ffffu;
+            value = (value | value << 8) & 0x00ff00ff00ff00ffu;
+            value = (value | value << 4) & 0x0f0f0f0f0f0f0f0fu;
+            value = (value | value << 2) & 0x3333333333333333u;
+            value = (value | value << 1) & 0x5555555555555555u;
+        }
+        else
+        {
+            value &= 0x00000000001fffffu;
+            value = (value | value << 32) & 0x001f00000000ffffu;
+            value = (value | value << 16) & 0x001f0000ff0000ffu;
+            value = (value | value << 8) & 0x100f00f00f00f00fu;
+            value = (value | value << 4) & 0x10c30c30c30c30c3u;
+            value = (value | value << 2) & 0x1249249249249249u;
+        }
+        return value;
+    }
+
+    // Moves the bit i * Dims of value to the bit i
+    template<std::size_t Dims>
+    constexpr auto compact(std::uint64_t value) noexcept
+        -> std::uint64_t
+    {
+#if defined(CPPGRAY_HAS_BMI2)
+        if (not CPPGRAY_IS_CONSTANT_EVALUATED())
+        {
+            return static_cast<std::uint64_t>(_pext_u64(value, spread_mask<Dims>()));
+        }
+#endif
+        if (Dims == 2)
+        {
+            value &= 0x5555555555555555u;
+            value = (value | value >> 1) & 0x3333333333333333u;
+            value = (value | value >> 2) & 0x0f0f0f0f0f0f0f0fu;
+            value = (value | value >> 4) & 0x00ff00ff00ff00ffu;
+            value = (value | value >> 8) & 0x0000ffff0000ffffu;
+            value = (value | value >> 16) & 0x00000000ffffffffu;
+        }
+        else
+        {
+            value &= 0x1249249249249249u;
+            value = (value | value >> 2) & 0x10c30c30c30c30c3u;
+            value = (value | value >> 4) & 0x100f00f00f00f00fu;
+            value = (value | value >> 8) & 0x001f0000ff0000ffu;
+            value = (value | value >> 16) & 0x001f00000000ffffu;
+            value = (value | value >> 32) & 0x00000000001fffffu;
+        }
+        return value;
+    }
+
+    // Interleaves the coordinates, the first one in the
+    // least significant bit of every group
+    template<typename Key, std::size_t Dims>
+    constexpr auto interleave(const std::uint64_t (&coords)[Dims]) noexcept
+        -> Key
+    {
+        constexpr std::uint64_t coord_mask = ~std::uint64_t(0) >> (64 - curve_bits<Key, Dims>());
+
+        std::uint64_t res = 0;
+        for (std::size_t i = 0 ; i < Dims ; ++i)
+        {
+            res |= spread<Dims>(coords[i] & coord_mask) << i;
+        }
+        return static_cast<Key>(res);
+    }
+
+    template<typename Key, std::size_t Dims>
+    constexpr auto deinterleave(Key key, std::uint64_t (&coords)[Dims]) noexcept
+        -> void
+    {
+        for (std::size_t i = 0 ; i < Dims ; ++i)
+        {
+            coords[i] = compact<Dims>(static_cast<std::uint64_t>(key) >> i);
+        }
+    }
+
+    // One step of Skilling's transform at a given level: the
+    // lower bits of the first coordinate are inverted when the
+    // bit of the level is set in the coordinate i, and they are
+    // exchanged with the lower bits of the coordinate i otherwise
+    template<std::size_t Dims>
+    constexpr auto hilbert_step(std::uint64_t (&coords)[Dims], std::size_t i,
+                                std::size_t level) noexcept
+        -> void
+    {
+        std::uint64_t low = (std::uint64_t(1) << level) - 1;
+        std::uint64_t invert = 0 - (coords[i] >> level & 1);
+        coords[0] ^= low & invert;
+        std::uint64_t swap = (coords[0] ^ coords[i]) & low & ~invert;
+        coords[0] ^= swap;
+        coords[i] ^= swap;
+    }
+
+    // Turns the coordinates into the transposed representation of
+    // the Hilbert key, up to the final Gray decoding
+    template<std::size_t Bits, std::size_t Dims>
+    constexpr auto axes_to_transpose(std::uint64_t (&coords)[Dims]) noexcept
+        -> void
+    {
+        for (std::size_t level = Bits - 1 ; level > 0 ; --level)
+        {
+            for (std::size_t i = 0 ; i < Dims ; ++i)
+            {
+                hilbert_step(coords, i, level);
+            }
+        }
+    }
+
+    template<std::size_t Bits, std::size_t Dims>
+    constexpr auto transpose_to_axes(std::uint64_t (&coords)[Dims]) noexcept
+        -> void
+    {
+        for (std::size_t level = 1 ; level < Bits ; ++level)
+        {
+            for (std::size_t i = Dims ; i-- > 0 ;)
+            {
+                hilbert_step(coords, i, level);
+            }
+        }
+    }
+
+    // The transposed representation stores the most significant
+    // bit of every group of the key in the first coordinate, the
+    // reverse of the Morton order
+    template<typename Key, std::size_t Dims>
+    constexpr auto hilbert_encode(std::uint64_t (&coords)[Dims]) noexcept
+        -> Key
+    {
+        constexpr std::size_t bits = curve_bits<Key, Dims>();
+        axes_to_transpose<bits>(coords);
+
+        std::uint64_t reversed[Dims] = {};
+        for (std::size_t i = 0 ; i < Dims ; ++i)
+        {
+            reversed[i] = coords[Dims - 1 - i];
+        }
+
+        gray_code<Key, bits * Dims> code;
+        code.value = interleave<Key>(reversed);
+        return static_cast<Key>(code);
+    }
+
+    template<typename Key, std::size_t Dims>
+    constexpr auto hilbert_decode(Key key, std::uint64_t (&coords)[Dims]) noexcept
+        -> void
+    {
+        constexpr std::size_t bits = curve_bits<Key, Dims>();
+
+        gray_code<Key, bits * Dims> code(key);
+        std::uint64_t reversed[Dims] = {};
+        deinterleave(code.value, reversed);
+        for (std::size_t i = 0 ; i < Dims ; ++i)
+        {
+            coords[i] = reversed[Dims - 1 - i];
+        }
+
+        transpose_to_axes<bits>(coords);
+    }
+
+    template<std::size_t Dims, std::size_t... Indices>
+    constexpr auto to_coords(const std::uint64_t (&coords)[Dims],
+                             std::index_sequence<Indices...>) noexcept
+        -> std::array<std::uint32_t, Dims>
+    {
+        return {{ static_cast<std::uint32_t>(coords[Indices])... }};
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Morton keys
+
+template<typename Key>
+constexpr auto morton_encode(std::uint32_t x, std::uint32_t y) noexcept
+    -> Key
+{
+    static_assert(detail::is_curve_key<Key>::value,
+                  "the key must be std::uint32_t or std::uint64_t");
+
+    const std::uint64_t coords[2] = { x, y };
+    return detail::interleave<Key>(coords);
+}
+
+template<typename Key>
+constexpr auto morton_encode(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept
+    -> Key
+{
+    static_assert(detail::is_curve_key<Key>::value,
+                  "the key must be std::uint32_t or std::uint64_t");
+
+    const std::uint64_t coords[3] = { x, y, z };
+    return detail::interleave<Key>(coords);
+}
+
+template<std::size_t Dims, typename Key>
+constexpr auto morton_decode(Key key) noexcept
+    -> std::array<std::uint32_t, Dims>
+{
+    static_assert(detail::is_curve_key<Key>::value,
+                  "the key must be std::uint32_t or std::uint64_t");
+    static_assert(Dims == 2 || Dims == 3, "only 2D and 3D keys are supported");
+
+    std::uint64_t coords[Dims] = {};
+    detail::deinterleave(key, coords);
+    return detail::to_coords(coords, std::make_index_sequence<Dims>{});
+}
+
+////////////////////////////////////////////////////////////
+// Hilbert keys
+
+template<typename Key>
+constexpr auto hilbert_encode(std::uint32_t x, std::uint32_t y) noexcept
+    -> Key
+{
+    static_assert(detail::is_curve_key<Key>::value,
+                  "the key must be std::uint32_t or std::uint64_t");
+
+    constexpr std::uint64_t coord_mask = ~std::uint64_t(0) >> (64 - detail::curve_bits<Key, 2>());
+    std::uint64_t coords[2] = { x & coord_mask, y & coord_mask };
+    return detail::hilbert_encode<Key>(coords);
+}
+
+template<typename Key>
+constexpr auto hilbert_encode(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept
+    -> Key
+{
+    static_assert(detail::is_curve_key<Key>::value,
+                  "the key must be std::uint32_t or std::uint64_t");
+
+    constexpr std::uint64_t coord_mask = ~std::uint64_t(0) >> (64 - detail::curve_bits<Key, 3>());
+    std::uint64_t coords[3] = { x & coord_mask, y & coord_mask, z & coord_mask };
+    return detail::hilbert_encode<Key>(coords);
+}
+
+template<std::size_t Dims, typename Key>
+constexpr auto hilbert_decode(Key key) noexcept
+    -> std::array<std::uint32_t, Dims>
+{
+    static_assert(detail::is_curve_key<Key>::value,
+                  "the key must be std::uint32_t or std::uint64_t");
+    static_assert(Dims == 2 || Dims == 3, "only 2D and 3D keys are supported");
+
+    std::uint64_t coords[Dims] = {};
+    detail::hilbert_decode(key, coords);
+    return detail::to_coords(coords, std::make_index_sequence<Dims>{});
+}
+
+////////////////////////////////////////////////////////////
+// Batch operations
+
+template<typename Key>
+auto morton_encode(const std::uint32_t* x, const std::uint32_t* y,
+                   Key* out, std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        out[i] = morton_encode<Key>(x[i], y[i]);
+    }
+}
+
+template<typename Key>
+auto morton_encode(const std::uint32_t* x, const std::uint32_t* y, const std::uint32_t* z,
+                   Key* out, std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        out[i] = morton_encode<Key>(x[i], y[i], z[i]);
+    }
+}
+
+template<typename Key>
+auto morton_decode(const Key* in, std::uint32_t* x, std::uint32_t* y,
+                   std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        auto coords = morton_decode<2>(in[i]);
+        x[i] = coords[0];
+        y[i] = coords[1];
+    }
+}
+
+template<typename Key>
+auto morton_decode(const Key* in, std::uint32_t* x, std::uint32_t* y, std::uint32_t* z,
+                   std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        auto coords = morton_decode<3>(in[i]);
+        x[i] = coords[0];
+        y[i] = coords[1];
+        z[i] = coords[2];
+    }
+}
+
+template<typename Key>
+auto hilbert_encode(const std::uint32_t* x, const std::uint32_t* y,
+                    Key* out, std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        out[i] = hilbert_encode<Key>(x[i], y[i]);
+    }
+}
+
+template<typename Key>
+auto hilbert_encode(const std::uint32_t* x, const std::uint32_t* y, const std::uint32_t* z,
+                    Key* out, std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        out[i] = hilbert_encode<Key>(x[i], y[i], z[i]);
+    }
+}
+
+template<typename Key>
+auto hilbert_decode(const Key* in, std::uint32_t* x, std::uint32_t* y,
+                    std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        auto coords = hilbert_decode<2>(in[i]);
+        x[i] = coords[0];
+        y[i] = coords[1];
+    }
+}
+
+template<typename Key>
+auto hilbert_decode(const Key* in, std::uint32_t* x, std::uint32_t* y, std::uint32_t* z,
+                    std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        auto coords = hilbert_decode<3>(in[i]);
+        x[i] = coords[0];
+        y[i] = coords[1];
+        z[i] = coords[2];
+    }
+}
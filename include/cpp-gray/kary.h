@@ -0,0 +1,219 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_KARY_H_
+#define CPPGRAY_KARY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "detail/type_traits.h"
+
+namespace cppgray
+{
+    namespace detail
+    {
+        // Base^digits - 1 when it fits in 64 bits, in which
+        // case fits is set to true
+        constexpr auto kary_max_value(unsigned base, std::size_t digits, bool& fits) noexcept
+            -> std::uint64_t
+        {
+            constexpr std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+            std::uint64_t res = 0;
+            fits = true;
+            for (std::size_t i = 0 ; i < digits ; ++i)
+            {
+                if (res > (max - (base - 1)) / base)
+                {
+                    fits = false;
+                    return 0;
+                }
+                res = res * base + (base - 1);
+            }
+            return res;
+        }
+
+        constexpr auto kary_fits(unsigned base, std::size_t digits) noexcept
+            -> bool
+        {
+            bool fits = false;
+            kary_max_value(base, digits, fits);
+            return fits;
+        }
+
+        constexpr auto kary_max_value(unsigned base, std::size_t digits) noexcept
+            -> std::uint64_t
+        {
+            bool fits = false;
+            return kary_max_value(base, digits, fits);
+        }
+
+        constexpr auto kary_bits(unsigned base, std::size_t digits) noexcept
+            -> std::size_t
+        {
+            std::size_t res = 0;
+            for (auto value = kary_max_value(base, digits) ; value ; value >>= 1)
+            {
+                ++res;
+            }
+            return res;
+        }
+
+        // Number of bits of a digit when base is a power of 2, 0 otherwise
+        constexpr auto kary_digit_bits(unsigned base) noexcept
+            -> std::size_t
+        {
+            if (base & (base - 1))
+            {
+                return 0;
+            }
+            std::size_t res = 0;
+            while (base >>= 1)
+            {
+                ++res;
+            }
+            return res;
+        }
+    }
+
+    /**
+     * @brief Reflected Gray code in base Base.
+     *
+     * This class represents an integer of Digits digits in base
+     * Base as a reflected k-ary Gray code: consecutive integers
+     * have codes that differ by exactly one in exactly one digit.
+     * A digit of the code is the matching digit of the integer,
+     * reversed (d becomes Base - 1 - d) when the sum of the digits
+     * of the code above it is odd.
+     *
+     * The value is stored as an integer of the smallest unsigned
+     * type able to hold Base^Digits - 1, whose digits in base Base
+     * are the digits of the code. When Base is a power of 2, the
+     * conversions only use shifts and masks, and every digit is
+     * a bit field of the underlying integer.
+     *
+     * auto pam = kary_gray_code<4, 3>{ 5 };  // digits 0 1 2
+     * pam.digit(0);                          // 2
+     * std::uint8_t u(pam);                   // u == 5
+     */
+    template<unsigned Base, std::size_t Digits>
+    struct kary_gray_code
+    {
+        static_assert(Base >= 2, "the base of a Gray code must be at least 2");
+        static_assert(Digits > 0, "a Gray code needs at least one digit");
+        static_assert(detail::kary_fits(Base, Digits),
+                      "Base^Digits - 1 must fit in a 64-bit unsigned integer");
+
+        // Smallest unsigned integer type holding every code
+        using value_type = detail::uint_least_t<detail::kary_bits(Base, Digits)>;
+
+        // Base of the Gray code
+        static constexpr unsigned base = Base;
+
+        // Number of digits of the Gray code
+        static constexpr std::size_t digits = Digits;
+
+        // Number of bits of a digit when Base is a power of 2, 0 otherwise
+        static constexpr std::size_t digit_bits = detail::kary_digit_bits(Base);
+
+        // Greatest integer of Digits digits, Base^Digits - 1
+        static constexpr value_type max_value =
+            static_cast<value_type>(detail::kary_max_value(Base, Digits));
+
+        // Integer whose digits in base Base are those of the code
+        value_type value;
+
+        ////////////////////////////////////////////////////////////
+        // Constructors operations
+
+        // Default constructor
+        constexpr kary_gray_code() noexcept;
+
+        /**
+         * @brief Construction from an unsigned integer.
+         *
+         * The integer is taken modulo Base^Digits, then
+         * converted to Gray code.
+         *
+         * @param value Unsigned integer to convert
+         */
+        constexpr explicit kary_gray_code(value_type value) noexcept;
+
+        ////////////////////////////////////////////////////////////
+        // Conversion operations
+
+        /**
+         * @brief Conversion to the underlying type.
+         */
+        constexpr explicit operator value_type() const noexcept;
+
+        ////////////////////////////////////////////////////////////
+        // Element access
+
+        /**
+         * @brief Digit of the code at a given position.
+         *
+         * @param pos Position of the digit, 0 being the least
+         *        significant one
+         */
+        constexpr auto digit(std::size_t pos) const noexcept
+            -> unsigned;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Comparison operations
+
+    template<unsigned Base, std::size_t Digits>
+    constexpr auto operator==(kary_gray_code<Base, Digits> lhs,
+                              kary_gray_code<Base, Digits> rhs) noexcept
+        -> bool;
+
+    template<unsigned Base, std::size_t Digits>
+    constexpr auto operator!=(kary_gray_code<Base, Digits> lhs,
+                              kary_gray_code<Base, Digits> rhs) noexcept
+        -> bool;
+
+    ////////////////////////////////////////////////////////////
+    // Batch operations
+    //
+    // Equivalent to converting every element; the loops are
+    // branchless for power-of-2 bases, so that the compiler
+    // can vectorize them
+
+    template<unsigned Base, std::size_t Digits>
+    auto encode(const typename kary_gray_code<Base, Digits>::value_type* in,
+                kary_gray_code<Base, Digits>* out, std::size_t size) noexcept
+        -> void;
+
+    template<unsigned Base, std::size_t Digits>
+    auto decode(const kary_gray_code<Base, Digits>* in,
+                typename kary_gray_code<Base, Digits>::value_type* out, std::size_t size) noexcept
+        -> void;
+
+    #include "kary.inl"
+}
+
+#endif // CPPGRAY_KARY_H_
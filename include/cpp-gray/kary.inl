@@ -0,0 +1,224 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Bit 0 of every digit of Digits digits of Bits bits
+    constexpr auto kary_low_bits(std::size_t bits, std::size_t digits) noexcept
+        -> std::uint64_t
+    {
+        std::uint64_t res = 0;
+        for (std::size_t i = 0 ; i < digits ; ++i)
+        {
+            res |= std::uint64_t(1) << (i * bits);
+        }
+        return res;
+    }
+
+    // Power-of-2 bases: every digit is reversed when bit 0 of the
+    // integer digit above it is set, which is done by spreading
+    // that bit with a subtraction: (t << k) - t sets the k bits
+    // of the digits where t has its bit 0 set
+    template<std::size_t DigitBits, std::size_t Digits>
+    constexpr auto kary_encode_bits(std::uint64_t value) noexcept
+        -> std::uint64_t
+    {
+        constexpr std::uint64_t low = kary_low_bits(DigitBits, Digits);
+        std::uint64_t reversed = (value & low) >> DigitBits;
+        return value ^ ((reversed << DigitBits) - reversed);
+    }
+
+    // The reversal of a digit depends on the parity of the digits
+    // of the code above it, which is the prefix xor over the digits
+    // of their bit 0, computed with the usual chain of shifts
+    template<std::size_t DigitBits, std::size_t Digits>
+    constexpr auto kary_decode_bits(std::uint64_t value) noexcept
+        -> std::uint64_t
+    {
+        constexpr std::uint64_t low = kary_low_bits(DigitBits, Digits);
+        std::uint64_t parity = value & low;
+        for (std::size_t shift = DigitBits ; shift < DigitBits * Digits ; shift <<= 1)
+        {
+            parity ^= parity >> shift;
+        }
+        std::uint64_t reversed = (parity >> DigitBits) & low;
+        return value ^ ((reversed << DigitBits) - reversed);
+    }
+
+    // Other bases: the digits are walked from the most significant
+    // one down, and a digit is reversed when the digits of the code
+    // above it have an odd sum; the same walk converts both ways,
+    // only the digit whose parity is tracked differs
+    template<unsigned Base, std::size_t Digits>
+    constexpr auto kary_convert_digits(std::uint64_t value, bool encoding) noexcept
+        -> std::uint64_t
+    {
+        unsigned digits[Digits] = {};
+        for (std::size_t i = 0 ; i < Digits ; ++i)
+        {
+            digits[i] = static_cast<unsigned>(value % Base);
+            value /= Base;
+        }
+
+        std::uint64_t res = 0;
+        unsigned odd = 0;
+        for (std::size_t i = Digits ; i-- > 0 ;)
+        {
+            unsigned digit = odd ? Base - 1 - digits[i] : digits[i];
+            odd ^= (encoding ? digit : digits[i]) & 1u;
+            res = res * Base + digit;
+        }
+        return res;
+    }
+
+    template<unsigned Base, std::size_t Digits>
+    constexpr auto kary_encode(std::uint64_t value) noexcept
+        -> std::uint64_t
+    {
+        constexpr std::size_t digit_bits = kary_gray_code<Base, Digits>::digit_bits;
+        constexpr std::uint64_t max_value = kary_gray_code<Base, Digits>::max_value;
+        if (digit_bits)
+        {
+            return kary_encode_bits<digit_bits, Digits>(value & max_value);
+        }
+        return kary_convert_digits<Base, Digits>(value % (max_value + 1), true);
+    }
+
+    template<unsigned Base, std::size_t Digits>
+    constexpr auto kary_decode(std::uint64_t value) noexcept
+        -> std::uint64_t
+    {
+        constexpr std::size_t digit_bits = kary_gray_code<Base, Digits>::digit_bits;
+        if (digit_bits)
+        {
+            return kary_decode_bits<digit_bits, Digits>(value);
+        }
+        return kary_convert_digits<Base, Digits>(value, false);
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Out-of-class definitions of static data members
+
+template<unsigned Base, std::size_t Digits>
+constexpr unsigned kary_gray_code<Base, Digits>::base;
+
+template<unsigned Base, std::size_t Digits>
+constexpr std::size_t kary_gray_code<Base, Digits>::digits;
+
+template<unsigned Base, std::size_t Digits>
+constexpr std::size_t kary_gray_code<Base, Digits>::digit_bits;
+
+template<unsigned Base, std::size_t Digits>
+constexpr typename kary_gray_code<Base, Digits>::value_type kary_gray_code<Base, Digits>::max_value;
+
+////////////////////////////////////////////////////////////
+// Construction operations
+
+template<unsigned Base, std::size_t Digits>
+constexpr kary_gray_code<Base, Digits>::kary_gray_code() noexcept:
+    value(0)
+{}
+
+template<unsigned Base, std::size_t Digits>
+constexpr kary_gray_code<Base, Digits>::kary_gray_code(value_type value) noexcept:
+    value(static_cast<value_type>(detail::kary_encode<Base, Digits>(value)))
+{}
+
+////////////////////////////////////////////////////////////
+// Conversion operations
+
+template<unsigned Base, std::size_t Digits>
+constexpr kary_gray_code<Base, Digits>::operator value_type() const noexcept
+{
+    return static_cast<value_type>(detail::kary_decode<Base, Digits>(value));
+}
+
+////////////////////////////////////////////////////////////
+// Element access
+
+template<unsigned Base, std::size_t Digits>
+constexpr auto kary_gray_code<Base, Digits>::digit(std::size_t pos) const noexcept
+    -> unsigned
+{
+    if (digit_bits)
+    {
+        return static_cast<unsigned>((std::uint64_t(value) >> (pos * digit_bits)) & (Base - 1));
+    }
+
+    std::uint64_t res = value;
+    for (std::size_t i = 0 ; i < pos ; ++i)
+    {
+        res /= Base;
+    }
+    return static_cast<unsigned>(res % Base);
+}
+
+////////////////////////////////////////////////////////////
+// Comparison operations
+
+template<unsigned Base, std::size_t Digits>
+constexpr auto operator==(kary_gray_code<Base, Digits> lhs,
+                          kary_gray_code<Base, Digits> rhs) noexcept
+    -> bool
+{
+    return lhs.value == rhs.value;
+}
+
+template<unsigned Base, std::size_t Digits>
+constexpr auto operator!=(kary_gray_code<Base, Digits> lhs,
+                          kary_gray_code<Base, Digits> rhs) noexcept
+    -> bool
+{
+    return lhs.value != rhs.value;
+}
+
+////////////////////////////////////////////////////////////
+// Batch operations
+
+template<unsigned Base, std::size_t Digits>
+auto encode(const typename kary_gray_code<Base, Digits>::value_type* in,
+            kary_gray_code<Base, Digits>* out, std::size_t size) noexcept
+    -> void
+{
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        out[i] = kary_gray_code<Base, Digits>(in[i]);
+    }
+}
+
+template<unsigned Base, std::size_t Digits>
+auto decode(const kary_gray_code<Base, Digits>* in,
+            typename kary_gray_code<Base, Digits>::value_type* out, std::size_t size) noexcept
+    -> void
+{
+    using value_type = typename kary_gray_code<Base, Digits>::value_type;
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        out[i] = static_cast<value_type>(in[i]);
+    }
+}
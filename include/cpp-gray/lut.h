@@ -0,0 +1,115 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_LUT_H_
+#define CPPGRAY_LUT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "gray.h"
+
+namespace cppgray
+{
+    /**
+     * @brief Type of the elements of a lookup table.
+     *
+     * Smallest standard unsigned type able to hold every
+     * integer of the given number of bits.
+     */
+    template<std::size_t Bits>
+    using gray_table_value_t = std::conditional_t<
+        (Bits <= 8), std::uint8_t, std::uint16_t
+    >;
+
+    /**
+     * @brief Type of a lookup table for a given number of bits.
+     *
+     * The table holds one element for every possible integer
+     * of the given number of bits.
+     */
+    template<std::size_t Bits>
+    using gray_table = std::array<gray_table_value_t<Bits>, std::size_t(1) << Bits>;
+
+    ////////////////////////////////////////////////////////////
+    // Table generators
+
+    /**
+     * @brief Table mapping Gray codes to the integers they represent.
+     *
+     * The table is entirely computed at compile time and can be
+     * placed in read-only memory, in which case decoding a Gray
+     * code of the given width boils down to a single load:
+     *
+     * static constexpr auto table = make_gray_decode_table<8>();
+     * table[0b1100]; // 0b1000
+     */
+    template<std::size_t Bits>
+    constexpr auto make_gray_decode_table() noexcept
+        -> gray_table<Bits>;
+
+    /**
+     * @brief Table mapping integers to their Gray code.
+     */
+    template<std::size_t Bits>
+    constexpr auto make_gray_encode_table() noexcept
+        -> gray_table<Bits>;
+
+    ////////////////////////////////////////////////////////////
+    // Decode policy
+
+    /**
+     * @brief Decodes Gray codes with a lookup table.
+     *
+     * The shift/xor decoding loop of gray_code needs a number
+     * of dependent steps logarithmic in the width of the code;
+     * this policy replaces it by a single lookup in a table of
+     * 2^Bits elements, which is generally faster for narrow
+     * codes. The table is a static constant shared by all the
+     * decoders of a given width.
+     *
+     * table_decoder<12> dec;
+     * auto value = dec(gray_code<std::uint16_t, 12>{});
+     */
+    template<std::size_t Bits>
+    struct table_decoder
+    {
+        static_assert(Bits > 0 && Bits <= 16,
+                      "lookup tables are only available for 1 to 16 bits");
+
+        static constexpr gray_table<Bits> table = make_gray_decode_table<Bits>();
+
+        template<typename Unsigned>
+        constexpr auto operator()(gray_code<Unsigned, Bits> code) const noexcept
+            -> Unsigned;
+    };
+
+    #include "lut.inl"
+}
+
+#endif // CPPGRAY_LUT_H_
@@ -0,0 +1,97 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    template<std::size_t Bits>
+    constexpr auto table_decode(std::size_t index) noexcept
+        -> gray_table_value_t<Bits>
+    {
+        gray_code<gray_table_value_t<Bits>, Bits> code;
+        code.value = static_cast<gray_table_value_t<Bits>>(index);
+        return static_cast<gray_table_value_t<Bits>>(code);
+    }
+
+    template<std::size_t Bits>
+    constexpr auto table_encode(std::size_t index) noexcept
+        -> gray_table_value_t<Bits>
+    {
+        return static_cast<gray_table_value_t<Bits>>(index ^ (index >> 1));
+    }
+
+    // The elements are generated by pack expansion since
+    // std::array can't be modified in C++14 constexpr functions
+
+    template<std::size_t Bits, std::size_t... Indices>
+    constexpr auto make_decode_table(std::index_sequence<Indices...>) noexcept
+        -> gray_table<Bits>
+    {
+        return {{ table_decode<Bits>(Indices)... }};
+    }
+
+    template<std::size_t Bits, std::size_t... Indices>
+    constexpr auto make_encode_table(std::index_sequence<Indices...>) noexcept
+        -> gray_table<Bits>
+    {
+        return {{ table_encode<Bits>(Indices)... }};
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Table generators
+
+template<std::size_t Bits>
+constexpr auto make_gray_decode_table() noexcept
+    -> gray_table<Bits>
+{
+    static_assert(Bits > 0 && Bits <= 16,
+                  "lookup tables are only available for 1 to 16 bits");
+    return detail::make_decode_table<Bits>(std::make_index_sequence<std::size_t(1) << Bits>{});
+}
+
+template<std::size_t Bits>
+constexpr auto make_gray_encode_table() noexcept
+    -> gray_table<Bits>
+{
+    static_assert(Bits > 0 && Bits <= 16,
+                  "lookup tables are only available for 1 to 16 bits");
+    return detail::make_encode_table<Bits>(std::make_index_sequence<std::size_t(1) << Bits>{});
+}
+
+////////////////////////////////////////////////////////////
+// Decode policy
+
+template<std::size_t Bits>
+constexpr gray_table<Bits> table_decoder<Bits>::table;
+
+template<std::size_t Bits>
+template<typename Unsigned>
+constexpr auto table_decoder<Bits>::operator()(gray_code<Unsigned, Bits> code) const noexcept
+    -> Unsigned
+{
+    return static_cast<Unsigned>(table[code.value]);
+}
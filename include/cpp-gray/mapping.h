@@ -0,0 +1,196 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_MAPPING_H_
+#define CPPGRAY_MAPPING_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "batch.h"
+#include "gray.h"
+#include "detail/config.h"
+#include "detail/type_traits.h"
+
+namespace cppgray
+{
+    namespace detail
+    {
+        // Whether the lines are distinct and fit in the given
+        // number of bits
+        template<std::size_t... Lines>
+        constexpr auto mapping_is_valid(std::size_t digits) noexcept
+            -> bool
+        {
+            const std::size_t lines[] = { Lines... };
+            for (std::size_t i = 0 ; i < sizeof...(Lines) ; ++i)
+            {
+                if (lines[i] >= digits)
+                {
+                    return false;
+                }
+                for (std::size_t j = 0 ; j < i ; ++j)
+                {
+                    if (lines[i] == lines[j])
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Whether the lines are in increasing order, in which case
+        // the mapping only drops some lines and doesn't reorder them
+        template<std::size_t... Lines>
+        constexpr auto mapping_is_monotonic() noexcept
+            -> bool
+        {
+            const std::size_t lines[] = { Lines... };
+            for (std::size_t i = 1 ; i < sizeof...(Lines) ; ++i)
+            {
+                if (lines[i] < lines[i - 1])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<std::size_t... Lines>
+        constexpr auto mapping_lines_mask() noexcept
+            -> std::uint64_t
+        {
+            const std::size_t lines[] = { Lines... };
+            std::uint64_t res = 0;
+            for (std::size_t i = 0 ; i < sizeof...(Lines) ; ++i)
+            {
+                res |= std::uint64_t(1) << lines[i];
+            }
+            return res;
+        }
+    }
+
+    /**
+     * @brief Compile-time wiring of the lines of a Gray encoder.
+     *
+     * Encoders are often wired to an input port with their bits in
+     * another order, and with some lines inverted. A mapping lists,
+     * for every bit of the Gray code from the least significant one,
+     * the line of the raw input word that carries it; Inverted is
+     * the mask of the raw lines that are active low. The lines that
+     * don't appear in the list are ignored.
+     *
+     * The conversions compute the Gray code directly from the raw
+     * word in registers. The lines moved by the same distance are
+     * grouped at compile time, so that the permutation takes a mask
+     * and a shift per group; when the lines keep their order, it is
+     * a single pext instruction with BMI2. The batch functions do
+     * the same with the SIMD instructions of batch.h, followed by
+     * the decoding steps, in a single pass over the buffers.
+     *
+     * // Gray bits 0 to 3 on lines 7 to 4, line 5 inverted
+     * using wiring = bit_mapping<std::uint8_t, 0x20, 7, 6, 5, 4>;
+     * wiring::decode(raw, positions, size);
+     */
+    template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+    struct bit_mapping
+    {
+        static_assert(detail::is_unsigned_integer<Unsigned>::value &&
+                      std::numeric_limits<Unsigned>::digits <= 64,
+                      "bit mappings only support built-in unsigned integers of up to 64 bits");
+        static_assert(sizeof...(Lines) > 0, "a bit mapping needs at least one line");
+        static_assert(detail::mapping_is_valid<Lines...>(std::numeric_limits<Unsigned>::digits),
+                      "the lines must be distinct and fit in the underlying type");
+
+        ////////////////////////////////////////////////////////////
+        // Member types and constants
+
+        // Type of the raw words and of the positions
+        using value_type = Unsigned;
+
+        // Gray code made of the mapped lines
+        using code_type = gray_code<Unsigned, sizeof...(Lines)>;
+
+        static constexpr std::size_t bits = sizeof...(Lines);
+
+        // Raw lines that are active low
+        static constexpr value_type inverted = Inverted;
+
+        // Raw lines carrying a bit of the Gray code
+        static constexpr value_type lines_mask =
+            static_cast<value_type>(detail::mapping_lines_mask<Lines...>());
+
+        ////////////////////////////////////////////////////////////
+        // Conversion operations
+
+        /**
+         * @brief Gray code carried by a raw word.
+         */
+        CPPGRAY_HOST_DEVICE static constexpr auto remap(value_type raw) noexcept
+            -> code_type;
+
+        /**
+         * @brief Position encoded by a raw word.
+         */
+        CPPGRAY_HOST_DEVICE static constexpr auto decode(value_type raw) noexcept
+            -> value_type;
+
+        /**
+         * @brief Raw word carrying a Gray code.
+         *
+         * The lines that are not part of the mapping are 0 in
+         * the raw word.
+         */
+        CPPGRAY_HOST_DEVICE static constexpr auto unmap(code_type code) noexcept
+            -> value_type;
+
+        /**
+         * @brief Raw word encoding a position.
+         */
+        CPPGRAY_HOST_DEVICE static constexpr auto encode(value_type value) noexcept
+            -> value_type;
+
+        ////////////////////////////////////////////////////////////
+        // Batch operations
+
+        /**
+         * @brief Converts size raw words to Gray codes.
+         */
+        static auto remap(const value_type* raw, code_type* out, std::size_t size) noexcept
+            -> void;
+
+        /**
+         * @brief Converts size raw words to positions.
+         */
+        static auto decode(const value_type* raw, value_type* out, std::size_t size) noexcept
+            -> void;
+    };
+
+    #include "mapping.inl"
+}
+
+#endif // CPPGRAY_MAPPING_H_
@@ -0,0 +1,317 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Lines moved by the same distance from their line to their
+    // bit of the Gray code, positive distances moving them right
+    struct mapping_group
+    {
+        int shift;
+        std::uint64_t mask;
+    };
+
+    template<std::size_t... Lines>
+    constexpr auto mapping_group_count() noexcept
+        -> std::size_t
+    {
+        const std::size_t lines[] = { Lines... };
+        std::size_t res = 0;
+        for (std::size_t i = 0 ; i < sizeof...(Lines) ; ++i)
+        {
+            bool seen = false;
+            for (std::size_t j = 0 ; j < i ; ++j)
+            {
+                seen = seen || lines[j] - j == lines[i] - i;
+            }
+            res += seen ? 0 : 1;
+        }
+        return res;
+    }
+
+    // Groups are numbered in the order of their lowest bit
+    template<std::size_t... Lines>
+    constexpr auto mapping_group_at(std::size_t index) noexcept
+        -> mapping_group
+    {
+        const std::size_t lines[] = { Lines... };
+        std::size_t count = 0;
+        for (std::size_t i = 0 ; i < sizeof...(Lines) ; ++i)
+        {
+            bool seen = false;
+            for (std::size_t j = 0 ; j < i ; ++j)
+            {
+                seen = seen || lines[j] - j == lines[i] - i;
+            }
+            if (seen)
+            {
+                continue;
+            }
+            if (count++ == index)
+            {
+                std::uint64_t mask = 0;
+                for (std::size_t j = i ; j < sizeof...(Lines) ; ++j)
+                {
+                    if (lines[j] - j == lines[i] - i)
+                    {
+                        mask |= std::uint64_t(1) << lines[j];
+                    }
+                }
+                return { static_cast<int>(lines[i]) - static_cast<int>(i), mask };
+            }
+        }
+        return { 0, 0 };
+    }
+
+    template<typename Unsigned>
+    CPPGRAY_HOST_DEVICE constexpr auto shift_bits(Unsigned value, int shift) noexcept
+        -> Unsigned
+    {
+        return static_cast<Unsigned>(shift >= 0 ? value >> shift : value << -shift);
+    }
+
+#if defined(CPPGRAY_SIMD_DISPATCH) && not defined(__clang__)
+    // Vectors are passed around as in the kernels of batch.h
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+    // Moves the lines of the groups Index to Count - 1 to their
+    // bit of the Gray code, or back to their lines, every group
+    // taking a mask and a shift
+    template<typename Unsigned, std::size_t Index, std::size_t Count, std::size_t... Lines>
+    struct mapping_steps
+    {
+        using next = mapping_steps<Unsigned, Index + 1, Count, Lines...>;
+
+        CPPGRAY_HOST_DEVICE static constexpr auto gather(Unsigned raw) noexcept
+            -> Unsigned
+        {
+            constexpr mapping_group group = mapping_group_at<Lines...>(Index);
+            auto bits = static_cast<Unsigned>(raw & group.mask);
+            return static_cast<Unsigned>(shift_bits(bits, group.shift) | next::gather(raw));
+        }
+
+        CPPGRAY_HOST_DEVICE static constexpr auto scatter(Unsigned code) noexcept
+            -> Unsigned
+        {
+            constexpr mapping_group group = mapping_group_at<Lines...>(Index);
+            auto bits = static_cast<Unsigned>(shift_bits(code, -group.shift) & group.mask);
+            return static_cast<Unsigned>(bits | next::scatter(code));
+        }
+
+        // Ors the lines of the groups into res, which avoids
+        // returning vectors (see lane_parity in batch.inl)
+        template<typename Ops>
+        static auto gather(Ops ops, const typename Ops::vector& raw, typename Ops::vector& res) noexcept
+            -> void
+        {
+            constexpr mapping_group group = mapping_group_at<Lines...>(Index);
+            auto bits = Ops::bit_and(raw, Ops::template broadcast<Unsigned>(static_cast<Unsigned>(group.mask)));
+            if (group.shift > 0)
+            {
+                bits = Ops::template shift_right<Unsigned>(bits, group.shift);
+            }
+            else if (group.shift < 0)
+            {
+                bits = Ops::template shift_left<Unsigned>(bits, -group.shift);
+            }
+            res = Ops::bit_or(res, bits);
+            next::gather(ops, raw, res);
+        }
+    };
+
+    template<typename Unsigned, std::size_t Count, std::size_t... Lines>
+    struct mapping_steps<Unsigned, Count, Count, Lines...>
+    {
+        CPPGRAY_HOST_DEVICE static constexpr auto gather(Unsigned) noexcept
+            -> Unsigned
+        {
+            return 0;
+        }
+
+        CPPGRAY_HOST_DEVICE static constexpr auto scatter(Unsigned) noexcept
+            -> Unsigned
+        {
+            return 0;
+        }
+
+        template<typename Ops>
+        static auto gather(Ops, const typename Ops::vector&, typename Ops::vector&) noexcept
+            -> void
+        {}
+    };
+
+    template<typename Unsigned, std::size_t... Lines>
+    using mapping_steps_t = mapping_steps<Unsigned, 0, mapping_group_count<Lines...>(), Lines...>;
+
+    ////////////////////////////////////////////////////////////
+    // SIMD kernels
+
+    template<typename Steps, std::size_t Bits, bool Decode, typename Unsigned>
+    auto mapping_kernel(no_simd_ops, const Unsigned*, Unsigned*, Unsigned, std::size_t) noexcept
+        -> std::size_t
+    {
+        return 0;
+    }
+
+    template<typename Steps, std::size_t Bits, bool Decode, typename Ops, typename Unsigned>
+    auto mapping_kernel(Ops ops, const Unsigned* in, Unsigned* out,
+                        Unsigned inverted, std::size_t size) noexcept
+        -> std::size_t
+    {
+        constexpr std::size_t lanes = Ops::size / sizeof(Unsigned);
+        const auto flip = Ops::template broadcast<Unsigned>(inverted);
+
+        std::size_t i = 0;
+        for (; i + lanes <= size ; i += lanes)
+        {
+            auto raw = Ops::bit_xor(Ops::load(in + i), flip);
+            auto v = Ops::template broadcast<Unsigned>(0);
+            Steps::gather(ops, raw, v);
+            if (Decode)
+            {
+                for (int shift = static_cast<int>(decode_shift(Bits)) ; shift ; shift >>= 1)
+                {
+                    v = Ops::bit_xor(v, Ops::template shift_right<Unsigned>(v, shift));
+                }
+            }
+            Ops::store(out + i, v);
+        }
+        return i;
+    }
+
+#if defined(CPPGRAY_SIMD_DISPATCH) && not defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+    template<typename Steps, std::size_t Bits, bool Decode>
+    struct mapping_op
+    {
+        template<typename Ops, typename Unsigned>
+        static auto apply(Ops ops, const Unsigned* in, Unsigned* out,
+                          Unsigned inverted, std::size_t size) noexcept
+            -> std::size_t
+        {
+            return mapping_kernel<Steps, Bits, Decode>(ops, in, out, inverted, size);
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////
+// Out-of-class definitions of static data members
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+constexpr std::size_t bit_mapping<Unsigned, Inverted, Lines...>::bits;
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+constexpr Unsigned bit_mapping<Unsigned, Inverted, Lines...>::inverted;
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+constexpr Unsigned bit_mapping<Unsigned, Inverted, Lines...>::lines_mask;
+
+////////////////////////////////////////////////////////////
+// Conversion operations
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+CPPGRAY_HOST_DEVICE constexpr auto bit_mapping<Unsigned, Inverted, Lines...>::remap(value_type raw) noexcept
+    -> code_type
+{
+    raw = static_cast<value_type>(raw ^ Inverted);
+
+    code_type res;
+#if defined(CPPGRAY_HAS_BMI2)
+    if (detail::mapping_is_monotonic<Lines...>() && not CPPGRAY_IS_CONSTANT_EVALUATED())
+    {
+        res.value = static_cast<value_type>(_pext_u64(raw, lines_mask));
+        return res;
+    }
+#endif
+    res.value = detail::mapping_steps_t<Unsigned, Lines...>::gather(raw);
+    return res;
+}
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+CPPGRAY_HOST_DEVICE constexpr auto bit_mapping<Unsigned, Inverted, Lines...>::decode(value_type raw) noexcept
+    -> value_type
+{
+    return static_cast<value_type>(remap(raw));
+}
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+CPPGRAY_HOST_DEVICE constexpr auto bit_mapping<Unsigned, Inverted, Lines...>::unmap(code_type code) noexcept
+    -> value_type
+{
+    constexpr auto flip = static_cast<value_type>(Inverted & lines_mask);
+#if defined(CPPGRAY_HAS_BMI2)
+    if (detail::mapping_is_monotonic<Lines...>() && not CPPGRAY_IS_CONSTANT_EVALUATED())
+    {
+        return static_cast<value_type>(_pdep_u64(code.value, lines_mask) ^ flip);
+    }
+#endif
+    return static_cast<value_type>(detail::mapping_steps_t<Unsigned, Lines...>::scatter(code.value) ^ flip);
+}
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+CPPGRAY_HOST_DEVICE constexpr auto bit_mapping<Unsigned, Inverted, Lines...>::encode(value_type value) noexcept
+    -> value_type
+{
+    return unmap(code_type(value));
+}
+
+////////////////////////////////////////////////////////////
+// Batch operations
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+auto bit_mapping<Unsigned, Inverted, Lines...>::remap(const value_type* raw, code_type* out,
+                                                      std::size_t size) noexcept
+    -> void
+{
+    using steps = detail::mapping_steps_t<Unsigned, Lines...>;
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{},
+                                       detail::mapping_op<steps, bits, false>{},
+                                       raw, reinterpret_cast<Unsigned*>(out), Inverted, size);
+    for (; i < size ; ++i)
+    {
+        out[i] = remap(raw[i]);
+    }
+}
+
+template<typename Unsigned, Unsigned Inverted, std::size_t... Lines>
+auto bit_mapping<Unsigned, Inverted, Lines...>::decode(const value_type* raw, value_type* out,
+                                                       std::size_t size) noexcept
+    -> void
+{
+    using steps = detail::mapping_steps_t<Unsigned, Lines...>;
+    std::size_t i = detail::run_kernel(detail::simd_ops_for_t<Unsigned>{},
+                                       detail::mapping_op<steps, bits, true>{},
+                                       raw, out, Inverted, size);
+    for (; i < size ; ++i)
+    {
+        out[i] = decode(raw[i]);
+    }
+}
@@ -0,0 +1,249 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_PACKED_VECTOR_H_
+#define CPPGRAY_PACKED_VECTOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "batch.h"
+#include "gray.h"
+#include "detail/type_traits.h"
+
+namespace cppgray
+{
+    /**
+     * @brief Dynamic array of densely packed Gray codes.
+     *
+     * The Gray codes are stored one after the other in 64-bit
+     * words, without any padding between them, so that a code
+     * of 12 bits only takes 12 bits of memory. A code may span
+     * two words. The words are followed by a padding word, which
+     * allows to extract any code with two loads and no branch.
+     *
+     * The elements are accessed through proxy references that
+     * convert to and from gray_code. The bulk decoding function
+     * extracts the codes chunk by chunk in the output buffer,
+     * then decodes every chunk in place with the SIMD functions
+     * of batch.h while it is still in cache.
+     *
+     * packed_gray_vector<12> vec(1000);
+     * vec[0] = gray(std::uint16_t(42));
+     * std::uint16_t values[1000];
+     * vec.decode(0, vec.size(), values);  // values[0] == 42
+     */
+    template<std::size_t Bits>
+    class packed_gray_vector
+    {
+        static_assert(Bits > 0 && Bits <= 64,
+                      "packed Gray codes must have 1 to 64 bits");
+
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using word_type  = std::uint64_t;
+            using value_type = gray_code<detail::uint_least_t<Bits>, Bits>;
+            using size_type  = std::size_t;
+
+            // Unsigned integer type of the decoded values
+            using integer_type = typename value_type::value_type;
+
+            class reference
+            {
+                public:
+
+                    reference(const reference&) = default;
+
+                    operator value_type() const noexcept
+                    {
+                        return _vec->get(_index);
+                    }
+
+                    auto operator=(value_type code) noexcept
+                        -> reference&
+                    {
+                        _vec->set(_index, code);
+                        return *this;
+                    }
+
+                    auto operator=(const reference& other) noexcept
+                        -> reference&
+                    {
+                        _vec->set(_index, other);
+                        return *this;
+                    }
+
+                    ////////////////////////////////////////////////////////////
+                    // Comparison operations
+                    //
+                    // The comparison operators of gray_code are templates,
+                    // which can't deduce their parameters from a proxy
+
+                    friend auto operator==(const reference& lhs, value_type rhs) noexcept
+                        -> bool
+                    {
+                        return value_type(lhs) == rhs;
+                    }
+
+                    friend auto operator==(value_type lhs, const reference& rhs) noexcept
+                        -> bool
+                    {
+                        return lhs == value_type(rhs);
+                    }
+
+                    friend auto operator==(const reference& lhs, const reference& rhs) noexcept
+                        -> bool
+                    {
+                        return value_type(lhs) == value_type(rhs);
+                    }
+
+                    friend auto operator!=(const reference& lhs, value_type rhs) noexcept
+                        -> bool
+                    {
+                        return value_type(lhs) != rhs;
+                    }
+
+                    friend auto operator!=(value_type lhs, const reference& rhs) noexcept
+                        -> bool
+                    {
+                        return lhs != value_type(rhs);
+                    }
+
+                    friend auto operator!=(const reference& lhs, const reference& rhs) noexcept
+                        -> bool
+                    {
+                        return value_type(lhs) != value_type(rhs);
+                    }
+
+                private:
+
+                    friend class packed_gray_vector;
+
+                    reference(packed_gray_vector* vec, size_type index) noexcept:
+                        _vec(vec),
+                        _index(index)
+                    {}
+
+                    packed_gray_vector* _vec;
+                    size_type _index;
+            };
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            packed_gray_vector();
+
+            /**
+             * @brief Vector of size Gray codes 0.
+             */
+            explicit packed_gray_vector(size_type size);
+
+            ////////////////////////////////////////////////////////////
+            // Element access
+
+            auto operator[](size_type index) noexcept
+                -> reference;
+            auto operator[](size_type index) const noexcept
+                -> value_type;
+
+            auto get(size_type index) const noexcept
+                -> value_type;
+            auto set(size_type index, value_type code) noexcept
+                -> void;
+
+            /**
+             * @brief Words holding the packed Gray codes.
+             *
+             * The code at index i starts at bit i * Bits, bit 0
+             * being the least significant bit of the first word.
+             */
+            auto words() const noexcept
+                -> const word_type*;
+
+            ////////////////////////////////////////////////////////////
+            // Capacity
+
+            auto size() const noexcept
+                -> size_type;
+            auto empty() const noexcept
+                -> bool;
+
+            auto reserve(size_type capacity)
+                -> void;
+
+            ////////////////////////////////////////////////////////////
+            // Modifiers
+
+            auto push_back(value_type code)
+                -> void;
+
+            /**
+             * @brief Changes the number of Gray codes.
+             *
+             * New Gray codes are initialized to 0.
+             */
+            auto resize(size_type size)
+                -> void;
+
+            auto clear() noexcept
+                -> void;
+
+            ////////////////////////////////////////////////////////////
+            // Bulk operations
+
+            /**
+             * @brief Copies count Gray codes starting at first.
+             */
+            auto unpack(size_type first, size_type count, value_type* out) const noexcept
+                -> void;
+
+            /**
+             * @brief Decodes count Gray codes starting at first.
+             *
+             * Equivalent to unpacking the Gray codes and converting
+             * them to the underlying integer type with the batch
+             * decode function, without any intermediate buffer.
+             */
+            auto decode(size_type first, size_type count, integer_type* out) const noexcept
+                -> void;
+
+        private:
+
+            // Raw bits of the Gray code at the given index
+            auto extract(size_type index) const noexcept
+                -> integer_type;
+
+            std::vector<word_type> _words;
+            size_type _size;
+    };
+
+    #include "packed_vector.inl"
+}
+
+#endif // CPPGRAY_PACKED_VECTOR_H_
@@ -0,0 +1,214 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Implementation details
+
+namespace detail
+{
+    // Number of words needed to store size Gray codes of
+    // the given number of bits, padding word included
+    constexpr auto packed_words(std::size_t size, std::size_t bits) noexcept
+        -> std::size_t
+    {
+        return (size * bits + 63) / 64 + 1;
+    }
+
+    // Number of Gray codes unpacked at once by the bulk
+    // operations before decoding them in place
+    constexpr std::size_t packed_chunk_size = 1024;
+}
+
+////////////////////////////////////////////////////////////
+// Construction
+
+template<std::size_t Bits>
+packed_gray_vector<Bits>::packed_gray_vector():
+    _words(1),
+    _size(0)
+{}
+
+template<std::size_t Bits>
+packed_gray_vector<Bits>::packed_gray_vector(size_type size):
+    _words(detail::packed_words(size, Bits)),
+    _size(size)
+{}
+
+////////////////////////////////////////////////////////////
+// Element access
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::operator[](size_type index) noexcept
+    -> reference
+{
+    return reference(this, index);
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::operator[](size_type index) const noexcept
+    -> value_type
+{
+    return get(index);
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::get(size_type index) const noexcept
+    -> value_type
+{
+    value_type res;
+    res.value = extract(index);
+    return res;
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::set(size_type index, value_type code) noexcept
+    -> void
+{
+    constexpr word_type mask = value_type::mask;
+    const size_type pos = index * Bits;
+    const size_type word = pos / 64;
+    const unsigned shift = pos % 64;
+    const word_type bits = code.value;
+
+    // The upper part is shifted in two steps since a shift
+    // by 64 bits would be undefined behaviour; it is empty
+    // when the code does not span two words
+    _words[word] = (_words[word] & ~(mask << shift)) | (bits << shift);
+    _words[word + 1] = (_words[word + 1] & ~((mask >> 1) >> (63 - shift)))
+                     | ((bits >> 1) >> (63 - shift));
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::words() const noexcept
+    -> const word_type*
+{
+    return _words.data();
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::extract(size_type index) const noexcept
+    -> integer_type
+{
+    const size_type pos = index * Bits;
+    const size_type word = pos / 64;
+    const unsigned shift = pos % 64;
+
+    // Reading the next word is always valid thanks to the
+    // padding word
+    word_type bits = (_words[word] >> shift) | ((_words[word + 1] << 1) << (63 - shift));
+    return static_cast<integer_type>(bits & value_type::mask);
+}
+
+////////////////////////////////////////////////////////////
+// Capacity
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::size() const noexcept
+    -> size_type
+{
+    return _size;
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::empty() const noexcept
+    -> bool
+{
+    return _size == 0;
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::reserve(size_type capacity)
+    -> void
+{
+    _words.reserve(detail::packed_words(capacity, Bits));
+}
+
+////////////////////////////////////////////////////////////
+// Modifiers
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::push_back(value_type code)
+    -> void
+{
+    resize(_size + 1);
+    set(_size - 1, code);
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::resize(size_type size)
+    -> void
+{
+    if (size < _size)
+    {
+        // Clear the bits of the removed codes so that the
+        // codes added by a later resize are 0
+        for (size_type i = size ; i < _size ; ++i)
+        {
+            set(i, value_type());
+        }
+    }
+    _words.resize(detail::packed_words(size, Bits));
+    _size = size;
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::clear() noexcept
+    -> void
+{
+    _words.assign(1, 0);
+    _size = 0;
+}
+
+////////////////////////////////////////////////////////////
+// Bulk operations
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::unpack(size_type first, size_type count, value_type* out) const noexcept
+    -> void
+{
+    for (size_type i = 0 ; i < count ; ++i)
+    {
+        out[i].value = extract(first + i);
+    }
+}
+
+template<std::size_t Bits>
+auto packed_gray_vector<Bits>::decode(size_type first, size_type count, integer_type* out) const noexcept
+    -> void
+{
+    for (size_type start = 0 ; start < count ; start += detail::packed_chunk_size)
+    {
+        size_type size = count - start < detail::packed_chunk_size ?
+                         count - start : detail::packed_chunk_size;
+
+        // Every code is extracted independently from the
+        // others, which lets the compiler vectorize the loop
+        integer_type* chunk = out + start;
+        for (size_type i = 0 ; i < size ; ++i)
+        {
+            chunk[i] = extract(first + start + i);
+        }
+        cppgray::decode(reinterpret_cast<const value_type*>(chunk), chunk, size);
+    }
+}
@@ -0,0 +1,404 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_RANGE_H_
+#define CPPGRAY_RANGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#if defined(CPPGRAY_USE_EXECUTION_POLICIES) && __cplusplus >= 201703L
+#   include <algorithm>
+#   include <execution>
+#   include <thread>
+#   include <utility>
+#   include <vector>
+#endif
+#include "gray.h"
+
+namespace cppgray
+{
+    namespace detail
+    {
+        // Index of the bit flipped to reach the Gray code at a
+        // given position, following the ruler sequence. Past the
+        // last code of a full-width sequence, the codes wrap around
+        // to 0 by flipping their highest bit, as with successor and
+        // predecessor. Position 0 has no predecessor and gives 64
+        template<typename Unsigned>
+        CPPGRAY_HOST_DEVICE constexpr auto gray_flip_bit(std::uint64_t position) noexcept
+            -> int
+        {
+            constexpr int digits = std::numeric_limits<Unsigned>::digits;
+            int bit = countr_zero(position);
+            if (position != 0 && bit >= digits)
+            {
+                bit = digits - 1;
+            }
+            return bit;
+        }
+    }
+
+    /**
+     * @brief Iterator over consecutive Gray codes.
+     *
+     * Moving from a Gray code to the next one flips exactly
+     * one bit, whose index is given by the number of trailing
+     * zeros of the position of the new code in the sequence
+     * (the ruler sequence). The iterator keeps track of that
+     * position so that it can report the flipped bit without
+     * having to compare the old and new codes. It is a random
+     * access iterator: moving it by any number of positions
+     * runs in constant time.
+     *
+     * The Gray codes are returned by value, so its iterator_category
+     * is input_iterator_tag, as for the iterators of std::ranges::iota_view,
+     * while its iterator_concept is random_access_iterator_tag.
+     *
+     * auto it = gray_range<unsigned>(3).begin();
+     * ++it;                // (*it).value == 0b001
+     * it.flipped_bit();    // 0
+     * ++it;                // (*it).value == 0b011
+     * it.flipped_bit();    // 1
+     */
+    template<typename Unsigned>
+    class gray_iterator
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using iterator_concept  = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = gray_code<Unsigned>;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = gray_code<Unsigned>;
+
+            // Position of a Gray code in the sequence
+            using position_type     = std::uint64_t;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            CPPGRAY_HOST_DEVICE constexpr gray_iterator() noexcept;
+
+            /**
+             * @brief Iterator to the Gray code at a given position.
+             *
+             * @param position Position in the sequence of Gray codes
+             */
+            CPPGRAY_HOST_DEVICE constexpr explicit gray_iterator(position_type position) noexcept;
+
+            ////////////////////////////////////////////////////////////
+            // Element access
+
+            CPPGRAY_HOST_DEVICE constexpr auto operator*() const noexcept
+                -> reference;
+
+            /**
+             * @brief Position of the current Gray code in the sequence.
+             */
+            CPPGRAY_HOST_DEVICE constexpr auto position() const noexcept
+                -> position_type;
+
+            /**
+             * @brief Index of the bit flipped to reach the current Gray code.
+             *
+             * That bit is the one that is flipped to go from the Gray
+             * code at the previous position to the current one, no matter
+             * how the iterator reached its current position. Positions
+             * past 1 << digits wrap around to the start of the sequence.
+             * The first Gray code of the sequence has no predecessor, in
+             * which case the function returns 64.
+             */
+            CPPGRAY_HOST_DEVICE constexpr auto flipped_bit() const noexcept
+                -> int;
+
+            CPPGRAY_HOST_DEVICE constexpr auto operator[](difference_type n) const noexcept
+                -> value_type;
+
+            ////////////////////////////////////////////////////////////
+            // Increment/decrement operations
+
+            CPPGRAY_HOST_DEVICE constexpr auto operator++() noexcept
+                -> gray_iterator&;
+            CPPGRAY_HOST_DEVICE constexpr auto operator++(int) noexcept
+                -> gray_iterator;
+
+            CPPGRAY_HOST_DEVICE constexpr auto operator--() noexcept
+                -> gray_iterator&;
+            CPPGRAY_HOST_DEVICE constexpr auto operator--(int) noexcept
+                -> gray_iterator;
+
+            ////////////////////////////////////////////////////////////
+            // Random access operations
+
+            CPPGRAY_HOST_DEVICE constexpr auto operator+=(difference_type n) noexcept
+                -> gray_iterator&;
+            CPPGRAY_HOST_DEVICE constexpr auto operator-=(difference_type n) noexcept
+                -> gray_iterator&;
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator+(gray_iterator it, difference_type n) noexcept
+                -> gray_iterator
+            {
+                return it += n;
+            }
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator+(difference_type n, gray_iterator it) noexcept
+                -> gray_iterator
+            {
+                return it += n;
+            }
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator-(gray_iterator it, difference_type n) noexcept
+                -> gray_iterator
+            {
+                return it -= n;
+            }
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator-(const gray_iterator& lhs,
+                                                                const gray_iterator& rhs) noexcept
+                -> difference_type
+            {
+                return static_cast<difference_type>(lhs._position - rhs._position);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Comparison operations
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator==(const gray_iterator& lhs,
+                                                                 const gray_iterator& rhs) noexcept
+                -> bool
+            {
+                return lhs._position == rhs._position;
+            }
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator!=(const gray_iterator& lhs,
+                                                                 const gray_iterator& rhs) noexcept
+                -> bool
+            {
+                return lhs._position != rhs._position;
+            }
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator<(const gray_iterator& lhs,
+                                                                const gray_iterator& rhs) noexcept
+                -> bool
+            {
+                return lhs._position < rhs._position;
+            }
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator<=(const gray_iterator& lhs,
+                                                                 const gray_iterator& rhs) noexcept
+                -> bool
+            {
+                return lhs._position <= rhs._position;
+            }
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator>(const gray_iterator& lhs,
+                                                                const gray_iterator& rhs) noexcept
+                -> bool
+            {
+                return lhs._position > rhs._position;
+            }
+
+            friend CPPGRAY_HOST_DEVICE constexpr auto operator>=(const gray_iterator& lhs,
+                                                                 const gray_iterator& rhs) noexcept
+                -> bool
+            {
+                return lhs._position >= rhs._position;
+            }
+
+        private:
+
+            // Bit flipped between the Gray codes at the current
+            // position and at the previous one
+            CPPGRAY_HOST_DEVICE constexpr auto flip_mask() const noexcept
+                -> Unsigned;
+
+            position_type _position;
+            gray_code<Unsigned> _code;
+    };
+
+    /**
+     * @brief Tag selecting the splitting constructor of gray_range.
+     */
+    struct split_tag {};
+
+    /**
+     * @brief Range of consecutive Gray codes.
+     *
+     * The range can cover the whole sequence of the Gray codes
+     * of a given number of bits, or only the codes at positions
+     * in [first, last). It is lazy and does not allocate.
+     *
+     * The range can be split in two halves, down to a grain
+     * size, which makes it a model of the Range concept of TBB:
+     * it can be passed to tbb::parallel_for as is. Every slice
+     * starts directly at the Gray code of its first position.
+     *
+     * for (auto code: gray_range<unsigned>(4)) {
+     *     // 0b0000, 0b0001, 0b0011, 0b0010, 0b0110...
+     * }
+     */
+    template<typename Unsigned>
+    class gray_range
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using iterator      = gray_iterator<Unsigned>;
+            using value_type    = gray_code<Unsigned>;
+            using position_type = typename iterator::position_type;
+            using size_type     = position_type;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            /**
+             * @brief Range of every Gray code of a given number of bits.
+             *
+             * @param bits Number of bits, no greater than the number of
+             *        bits of Unsigned and lower than 64
+             */
+            CPPGRAY_HOST_DEVICE constexpr explicit gray_range(std::size_t bits) noexcept;
+
+            /**
+             * @brief Range of the Gray codes at positions [first, last).
+             *
+             * @param grain_size Size under which the range can't be split
+             */
+            CPPGRAY_HOST_DEVICE constexpr gray_range(position_type first, position_type last,
+                                                     size_type grain_size = 1) noexcept;
+
+            /**
+             * @brief Splitting constructor.
+             *
+             * The new range takes the second half of other, which
+             * keeps the first half. Split is only used to select
+             * this constructor: split_tag, but also tbb::split.
+             */
+            template<typename Split>
+            CPPGRAY_HOST_DEVICE constexpr gray_range(gray_range& other, Split) noexcept;
+
+            ////////////////////////////////////////////////////////////
+            // Iterators
+
+            CPPGRAY_HOST_DEVICE constexpr auto begin() const noexcept
+                -> iterator;
+            CPPGRAY_HOST_DEVICE constexpr auto end() const noexcept
+                -> iterator;
+
+            ////////////////////////////////////////////////////////////
+            // Capacity
+
+            CPPGRAY_HOST_DEVICE constexpr auto size() const noexcept
+                -> size_type;
+            CPPGRAY_HOST_DEVICE constexpr auto empty() const noexcept
+                -> bool;
+
+            ////////////////////////////////////////////////////////////
+            // Splitting
+
+            CPPGRAY_HOST_DEVICE constexpr auto grain_size() const noexcept
+                -> size_type;
+
+            /**
+             * @brief Whether the range is larger than its grain size.
+             */
+            CPPGRAY_HOST_DEVICE constexpr auto is_divisible() const noexcept
+                -> bool;
+
+        private:
+
+            position_type _first;
+            position_type _last;
+            size_type _grain_size;
+    };
+
+    /**
+     * @brief Calls a function for every bit flip of a Gray sequence.
+     *
+     * Enumerating the Gray codes of a given number of bits in order
+     * flips exactly one bit at each step: this function calls f with
+     * the index of the flipped bit at each of these 2^bits - 1 steps.
+     * This is the most efficient way to enumerate every subset of a
+     * set by adding or removing one element at a time.
+     *
+     * @param bits Number of bits of the sequence, lower than 64
+     * @param func Function called with the index of every flipped bit
+     * @return func
+     */
+    template<typename Function>
+    CPPGRAY_HOST_DEVICE constexpr auto for_each_gray_flip(std::size_t bits, Function func)
+        -> Function;
+
+    /**
+     * @brief Calls a function for every bit flip of a range.
+     *
+     * Calls f with the index of the bit flipped at each of the
+     * size() - 1 steps between consecutive Gray codes of the
+     * range. Starting from the first Gray code of a slice of a
+     * sequence and applying the flips reproduces the slice.
+     *
+     * @param range Range of Gray codes
+     * @param func Function called with the index of every flipped bit
+     * @return func
+     */
+    template<typename Unsigned, typename Function>
+    CPPGRAY_HOST_DEVICE constexpr auto for_each_gray_flip(const gray_range<Unsigned>& range, Function func)
+        -> Function;
+
+#if defined(CPPGRAY_USE_EXECUTION_POLICIES) && defined(__cpp_lib_execution)
+    /**
+     * @brief Calls a function on slices of a range in parallel.
+     *
+     * The range is cut into contiguous slices of at least its
+     * grain size, with enough slices for every thread to get
+     * several of them, and func is called on every slice
+     * following the given standard execution policy. As with
+     * the parallel functions of batch.h, the macro
+     * CPPGRAY_USE_EXECUTION_POLICIES has to be defined for
+     * this function to be available.
+     *
+     * @param policy Standard execution policy
+     * @param range Range of Gray codes to cut
+     * @param func Function called with every slice
+     */
+    template<typename ExecutionPolicy, typename Unsigned, typename Function>
+    auto for_each_slice(ExecutionPolicy&& policy, const gray_range<Unsigned>& range, Function func)
+        -> std::enable_if_t<std::is_execution_policy<std::decay_t<ExecutionPolicy>>::value>;
+#endif
+
+    #include "range.inl"
+}
+
+#endif // CPPGRAY_RANGE_H_
@@ -0,0 +1,279 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// gray_iterator construction
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr gray_iterator<Unsigned>::gray_iterator() noexcept:
+    _position(0),
+    _code()
+{}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr gray_iterator<Unsigned>::gray_iterator(position_type position) noexcept:
+    _position(position),
+    _code(static_cast<Unsigned>(position))
+{}
+
+////////////////////////////////////////////////////////////
+// gray_iterator element access
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::operator*() const noexcept
+    -> reference
+{
+    return _code;
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::position() const noexcept
+    -> position_type
+{
+    return _position;
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::flipped_bit() const noexcept
+    -> int
+{
+    return detail::gray_flip_bit<Unsigned>(_position);
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::operator[](difference_type n) const noexcept
+    -> value_type
+{
+    return *(*this + n);
+}
+
+////////////////////////////////////////////////////////////
+// gray_iterator increment/decrement operations
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::operator++() noexcept
+    -> gray_iterator&
+{
+    ++_position;
+    _code.value ^= flip_mask();
+    return *this;
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::operator++(int) noexcept
+    -> gray_iterator
+{
+    auto res = *this;
+    operator++();
+    return res;
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::operator--() noexcept
+    -> gray_iterator&
+{
+    _code.value ^= flip_mask();
+    --_position;
+    return *this;
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::operator--(int) noexcept
+    -> gray_iterator
+{
+    auto res = *this;
+    operator--();
+    return res;
+}
+
+////////////////////////////////////////////////////////////
+// gray_iterator random access operations
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::operator+=(difference_type n) noexcept
+    -> gray_iterator&
+{
+    _position += static_cast<position_type>(n);
+    _code = gray_code<Unsigned>(static_cast<Unsigned>(_position));
+    return *this;
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::operator-=(difference_type n) noexcept
+    -> gray_iterator&
+{
+    _position -= static_cast<position_type>(n);
+    _code = gray_code<Unsigned>(static_cast<Unsigned>(_position));
+    return *this;
+}
+
+////////////////////////////////////////////////////////////
+// gray_iterator helpers
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_iterator<Unsigned>::flip_mask() const noexcept
+    -> Unsigned
+{
+    return static_cast<Unsigned>(Unsigned(1) << detail::gray_flip_bit<Unsigned>(_position));
+}
+
+////////////////////////////////////////////////////////////
+// gray_range construction
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr gray_range<Unsigned>::gray_range(std::size_t bits) noexcept:
+    _first(0),
+    _last(position_type(1) << bits),
+    _grain_size(1)
+{}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr gray_range<Unsigned>::gray_range(position_type first, position_type last,
+                                                               size_type grain_size) noexcept:
+    _first(first),
+    _last(last),
+    _grain_size(grain_size)
+{}
+
+template<typename Unsigned>
+template<typename Split>
+CPPGRAY_HOST_DEVICE constexpr gray_range<Unsigned>::gray_range(gray_range& other, Split) noexcept:
+    _first(other._first + other.size() / 2),
+    _last(other._last),
+    _grain_size(other._grain_size)
+{
+    other._last = _first;
+}
+
+////////////////////////////////////////////////////////////
+// gray_range iterators
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_range<Unsigned>::begin() const noexcept
+    -> iterator
+{
+    return iterator(_first);
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_range<Unsigned>::end() const noexcept
+    -> iterator
+{
+    return iterator(_last);
+}
+
+////////////////////////////////////////////////////////////
+// gray_range capacity
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_range<Unsigned>::size() const noexcept
+    -> size_type
+{
+    return _last - _first;
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_range<Unsigned>::empty() const noexcept
+    -> bool
+{
+    return _first == _last;
+}
+
+////////////////////////////////////////////////////////////
+// gray_range splitting
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_range<Unsigned>::grain_size() const noexcept
+    -> size_type
+{
+    return _grain_size;
+}
+
+template<typename Unsigned>
+CPPGRAY_HOST_DEVICE constexpr auto gray_range<Unsigned>::is_divisible() const noexcept
+    -> bool
+{
+    return size() > _grain_size;
+}
+
+////////////////////////////////////////////////////////////
+// Flip enumeration
+
+template<typename Function>
+CPPGRAY_HOST_DEVICE constexpr auto for_each_gray_flip(std::size_t bits, Function func)
+    -> Function
+{
+    const std::uint64_t last = std::uint64_t(1) << bits;
+    for (std::uint64_t i = 1 ; i < last ; ++i)
+    {
+        func(detail::countr_zero(i));
+    }
+    return func;
+}
+
+template<typename Unsigned, typename Function>
+CPPGRAY_HOST_DEVICE constexpr auto for_each_gray_flip(const gray_range<Unsigned>& range, Function func)
+    -> Function
+{
+    // The bit flipped to reach position i is given by the
+    // ruler sequence, whatever the first position
+    const std::uint64_t last = range.end().position();
+    for (std::uint64_t i = range.begin().position() + 1 ; i < last ; ++i)
+    {
+        func(detail::gray_flip_bit<Unsigned>(i));
+    }
+    return func;
+}
+
+#if defined(CPPGRAY_USE_EXECUTION_POLICIES) && defined(__cpp_lib_execution)
+template<typename ExecutionPolicy, typename Unsigned, typename Function>
+auto for_each_slice(ExecutionPolicy&& policy, const gray_range<Unsigned>& range, Function func)
+    -> std::enable_if_t<std::is_execution_policy<std::decay_t<ExecutionPolicy>>::value>
+{
+    using size_type = typename gray_range<Unsigned>::size_type;
+
+    // A few slices per thread let the scheduler balance the load
+    // when some slices take longer than others
+    const size_type threads = std::thread::hardware_concurrency() ?
+                              std::thread::hardware_concurrency() : 1;
+    size_type slice_size = (range.size() + threads * 8 - 1) / (threads * 8);
+    if (slice_size < range.grain_size())
+    {
+        slice_size = range.grain_size();
+    }
+    if (slice_size == 0)
+    {
+        slice_size = 1;
+    }
+
+    std::vector<gray_range<Unsigned>> slices;
+    const auto first = range.begin().position();
+    const auto last = range.end().position();
+    for (auto pos = first ; pos < last ; pos += slice_size)
+    {
+        slices.emplace_back(pos, last - pos < slice_size ? last : pos + slice_size);
+    }
+    std::for_each(std::forward<ExecutionPolicy>(policy), slices.begin(), slices.end(), func);
+}
+#endif
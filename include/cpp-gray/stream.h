@@ -0,0 +1,132 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_STREAM_H_
+#define CPPGRAY_STREAM_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "gray.h"
+
+namespace cppgray
+{
+    /**
+     * @brief Incremental decoder for a stream of Gray code samples.
+     *
+     * Consecutive samples read from a Gray encoder generally
+     * differ by a single bit. When bit k flips, the bits 0 to
+     * k of the decoded value flip, which is much cheaper than
+     * decoding the whole Gray code again. The decoder keeps the
+     * last sample and its decoded value, updates the value that
+     * way when a single bit changed, and falls back to a full
+     * decode otherwise. Such samples, where more than one bit
+     * changed, are counted as glitches. A sample that differs
+     * by a single bit isn't a glitch even when it skips some
+     * positions, as from 2 (0b011) to 5 (0b111).
+     *
+     * gray_stream_decoder<std::uint16_t> dec;
+     * dec.update(gray(std::uint16_t(1)));  // 1
+     * dec.update(gray(std::uint16_t(2)));  // 2
+     * dec.update(gray(std::uint16_t(4)));  // 4, dec.glitches() == 1
+     */
+    template<typename Unsigned, std::size_t Bits = std::numeric_limits<Unsigned>::digits>
+    class gray_stream_decoder
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using value_type = Unsigned;
+            using code_type  = gray_code<Unsigned, Bits>;
+            using count_type = std::uint64_t;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            /**
+             * @brief Decoder whose last sample is the Gray code 0.
+             */
+            constexpr gray_stream_decoder() noexcept;
+
+            /**
+             * @brief Decoder whose last sample is the given Gray code.
+             */
+            constexpr explicit gray_stream_decoder(code_type initial) noexcept;
+
+            /**
+             * @brief Restarts the decoder from the given Gray code.
+             *
+             * The glitch counter is reset as well.
+             */
+            constexpr auto reset(code_type initial) noexcept
+                -> void;
+
+            ////////////////////////////////////////////////////////////
+            // Decoding
+
+            /**
+             * @brief Feeds a new sample to the decoder.
+             *
+             * @return Decoded value of the sample
+             */
+            constexpr auto update(code_type sample) noexcept
+                -> value_type;
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            /**
+             * @brief Decoded value of the last sample.
+             */
+            constexpr auto value() const noexcept
+                -> value_type;
+
+            /**
+             * @brief Last sample fed to the decoder.
+             */
+            constexpr auto code() const noexcept
+                -> code_type;
+
+            /**
+             * @brief Number of samples that differed by
+             *        more than one bit from the previous one.
+             */
+            constexpr auto glitches() const noexcept
+                -> count_type;
+
+        private:
+
+            code_type _code;
+            value_type _value;
+            count_type _glitches;
+    };
+
+    #include "stream.inl"
+}
+
+#endif // CPPGRAY_STREAM_H_
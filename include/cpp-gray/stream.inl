@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Construction
+
+template<typename Unsigned, std::size_t Bits>
+constexpr gray_stream_decoder<Unsigned, Bits>::gray_stream_decoder() noexcept:
+    _code(),
+    _value(0),
+    _glitches(0)
+{}
+
+template<typename Unsigned, std::size_t Bits>
+constexpr gray_stream_decoder<Unsigned, Bits>::gray_stream_decoder(code_type initial) noexcept:
+    _code(initial),
+    _value(static_cast<value_type>(initial)),
+    _glitches(0)
+{}
+
+template<typename Unsigned, std::size_t Bits>
+constexpr auto gray_stream_decoder<Unsigned, Bits>::reset(code_type initial) noexcept
+    -> void
+{
+    _code = initial;
+    _value = static_cast<value_type>(initial);
+    _glitches = 0;
+}
+
+////////////////////////////////////////////////////////////
+// Decoding
+
+template<typename Unsigned, std::size_t Bits>
+constexpr auto gray_stream_decoder<Unsigned, Bits>::update(code_type sample) noexcept
+    -> value_type
+{
+    auto diff = static_cast<value_type>(sample.value ^ _code.value);
+    if (diff != 0)
+    {
+        if ((diff & (diff - 1u)) == 0)
+        {
+            // Only bit k changed: flip bits 0 to k of the
+            // decoded value, wrapping around for the top bit
+            auto low_bits = static_cast<value_type>((diff << 1u) - 1u);
+            _value ^= static_cast<value_type>(low_bits & code_type::mask);
+        }
+        else
+        {
+            _value = static_cast<value_type>(sample);
+            ++_glitches;
+        }
+        _code = sample;
+    }
+    return _value;
+}
+
+////////////////////////////////////////////////////////////
+// Observers
+
+template<typename Unsigned, std::size_t Bits>
+constexpr auto gray_stream_decoder<Unsigned, Bits>::value() const noexcept
+    -> value_type
+{
+    return _value;
+}
+
+template<typename Unsigned, std::size_t Bits>
+constexpr auto gray_stream_decoder<Unsigned, Bits>::code() const noexcept
+    -> code_type
+{
+    return _code;
+}
+
+template<typename Unsigned, std::size_t Bits>
+constexpr auto gray_stream_decoder<Unsigned, Bits>::glitches() const noexcept
+    -> count_type
+{
+    return _glitches;
+}
@@ -0,0 +1,302 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_TRACE_H_
+#define CPPGRAY_TRACE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "gray.h"
+
+namespace cppgray
+{
+    namespace detail
+    {
+        // Number of bits of the tokens of a trace of Bits-bit
+        // Gray codes: flip indices 0 to Bits - 1, then the repeat
+        // and escape tokens
+        constexpr auto trace_token_bits(std::size_t bits) noexcept
+            -> unsigned
+        {
+            unsigned res = 1;
+            while ((std::size_t(1) << res) < bits + 2)
+            {
+                ++res;
+            }
+            return res;
+        }
+    }
+
+    /**
+     * @brief Writes Gray encoder samples to a compact trace.
+     *
+     * Samples read from a Gray encoder are stored in a trace as
+     * a stream of small tokens, packed one after the other in
+     * 64-bit words from the least significant bit, without any
+     * padding. Every token is trace_token_bits(Bits) bits wide,
+     * 6 bits for 32-bit Gray codes, and means one of:
+     *
+     * - k < Bits: the sample is the previous one with bit k flipped
+     * - Bits: the sample is the same as the previous one
+     * - Bits + 1: escape, the sample is stored as is in the
+     *   following Bits bits
+     *
+     * Every keyframe_interval-th sample, starting with the first
+     * one, is a keyframe stored with an escape token whatever its
+     * previous sample is. The writer records the bit offset of
+     * every keyframe so that a reader can seek to any sample by
+     * jumping to the keyframe before it, then replaying at most
+     * keyframe_interval - 1 tokens. A stored trace thus consists
+     * of the words, the keyframe offsets, the number of samples
+     * and the keyframe interval.
+     */
+    template<typename Unsigned, std::size_t Bits = std::numeric_limits<Unsigned>::digits>
+    class gray_trace_writer
+    {
+        static_assert(Bits <= 64, "traces only support Gray codes of up to 64 bits");
+
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using code_type = gray_code<Unsigned, Bits>;
+            using word_type = std::uint64_t;
+            using size_type = std::size_t;
+
+            static constexpr unsigned token_bits = detail::trace_token_bits(Bits);
+            static constexpr word_type repeat_token = Bits;
+            static constexpr word_type escape_token = Bits + 1;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            /**
+             * @brief Empty trace with a keyframe every keyframe_interval
+             *        samples.
+             *
+             * The keyframe interval must be greater than 0.
+             */
+            explicit gray_trace_writer(size_type keyframe_interval = 4096);
+
+            ////////////////////////////////////////////////////////////
+            // Modifiers
+
+            /**
+             * @brief Appends a sample to the trace.
+             */
+            auto push(code_type sample)
+                -> void;
+
+            /**
+             * @brief Appends count samples to the trace.
+             */
+            auto push(const code_type* samples, size_type count)
+                -> void;
+
+            /**
+             * @brief Removes every sample from the trace.
+             */
+            auto clear() noexcept
+                -> void;
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            /**
+             * @brief Number of samples in the trace.
+             */
+            auto size() const noexcept
+                -> size_type;
+
+            auto keyframe_interval() const noexcept
+                -> size_type;
+
+            /**
+             * @brief Number of bits used by the tokens.
+             */
+            auto bit_size() const noexcept
+                -> std::uint64_t;
+
+            /**
+             * @brief Words holding the tokens.
+             */
+            auto words() const noexcept
+                -> const std::vector<word_type>&;
+
+            /**
+             * @brief Bit offsets of the keyframes, one for every
+             *        keyframe_interval samples.
+             */
+            auto keyframes() const noexcept
+                -> const std::vector<std::uint64_t>&;
+
+        private:
+
+            auto append(word_type bits, unsigned width)
+                -> void;
+
+            std::vector<word_type> _words;
+            std::vector<std::uint64_t> _keyframes;
+            std::uint64_t _bit_size;
+            size_type _size;
+            size_type _keyframe_interval;
+            code_type _last;
+    };
+
+    /**
+     * @brief Reads back the samples of a trace.
+     *
+     * The reader does not own the trace and reads the samples
+     * one after the other, from the first one or from the one
+     * it was moved to with seek. A sample that differs by a
+     * single bit from the previous one updates the decoded
+     * position by flipping its bits 0 to k, as a stream decoder
+     * would, so that reading positions needs a full decode only
+     * after escape tokens.
+     *
+     * gray_trace_writer<std::uint32_t> writer;
+     * // writer.push(...)
+     * gray_trace_reader<std::uint32_t> reader(writer);
+     * reader.seek(123456);
+     * reader.read(positions, 1000);  // positions of samples 123456 to 124455
+     */
+    template<typename Unsigned, std::size_t Bits = std::numeric_limits<Unsigned>::digits>
+    class gray_trace_reader
+    {
+        static_assert(Bits <= 64, "traces only support Gray codes of up to 64 bits");
+
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using code_type  = gray_code<Unsigned, Bits>;
+            using value_type = Unsigned;
+            using word_type  = std::uint64_t;
+            using size_type  = std::size_t;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            /**
+             * @brief Reader for a stored trace.
+             *
+             * @param words Words holding the tokens
+             * @param size Number of samples in the trace
+             * @param keyframes Bit offsets of the keyframes
+             * @param keyframe_interval Number of samples between keyframes
+             */
+            gray_trace_reader(const word_type* words, size_type size,
+                              const std::uint64_t* keyframes,
+                              size_type keyframe_interval) noexcept;
+
+            /**
+             * @brief Reader for the samples of a writer.
+             *
+             * The reader is invalidated when samples are appended
+             * to the writer.
+             */
+            explicit gray_trace_reader(const gray_trace_writer<Unsigned, Bits>& writer) noexcept;
+
+            ////////////////////////////////////////////////////////////
+            // Reading operations
+
+            /**
+             * @brief Reads the next sample.
+             *
+             * There must be samples left to read.
+             */
+            auto next() noexcept
+                -> code_type;
+
+            /**
+             * @brief Reads up to count samples, converted to positions.
+             *
+             * @return Number of positions written to out
+             */
+            auto read(value_type* out, size_type count) noexcept
+                -> size_type;
+
+            /**
+             * @brief Moves the reader so that the next sample read
+             *        is the one at the given index.
+             *
+             * The index must be lower than or equal to size().
+             */
+            auto seek(size_type index) noexcept
+                -> void;
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            auto size() const noexcept
+                -> size_type;
+
+            /**
+             * @brief Index of the next sample to read.
+             */
+            auto position() const noexcept
+                -> size_type;
+
+            /**
+             * @brief Last sample read.
+             */
+            auto code() const noexcept
+                -> code_type;
+
+            /**
+             * @brief Position of the last sample read.
+             */
+            auto value() const noexcept
+                -> value_type;
+
+        private:
+
+            static constexpr unsigned token_bits = detail::trace_token_bits(Bits);
+
+            auto fetch(unsigned width) noexcept
+                -> word_type;
+
+            auto step() noexcept
+                -> void;
+
+            const word_type* _words;
+            const std::uint64_t* _keyframes;
+            size_type _size;
+            size_type _keyframe_interval;
+            size_type _position;
+            std::uint64_t _bit_offset;
+            code_type _code;
+            value_type _value;
+    };
+
+    #include "trace.inl"
+}
+
+#endif // CPPGRAY_TRACE_H_
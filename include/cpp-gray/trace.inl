@@ -0,0 +1,309 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Out-of-class definitions of static data members
+
+template<typename Unsigned, std::size_t Bits>
+constexpr unsigned gray_trace_writer<Unsigned, Bits>::token_bits;
+
+template<typename Unsigned, std::size_t Bits>
+constexpr typename gray_trace_writer<Unsigned, Bits>::word_type gray_trace_writer<Unsigned, Bits>::repeat_token;
+
+template<typename Unsigned, std::size_t Bits>
+constexpr typename gray_trace_writer<Unsigned, Bits>::word_type gray_trace_writer<Unsigned, Bits>::escape_token;
+
+template<typename Unsigned, std::size_t Bits>
+constexpr unsigned gray_trace_reader<Unsigned, Bits>::token_bits;
+
+////////////////////////////////////////////////////////////
+// Writer construction
+
+template<typename Unsigned, std::size_t Bits>
+gray_trace_writer<Unsigned, Bits>::gray_trace_writer(size_type keyframe_interval):
+    _words(),
+    _keyframes(),
+    _bit_size(0),
+    _size(0),
+    _keyframe_interval(keyframe_interval),
+    _last()
+{}
+
+////////////////////////////////////////////////////////////
+// Writer modifiers
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::push(code_type sample)
+    -> void
+{
+    if (_size % _keyframe_interval == 0)
+    {
+        _keyframes.push_back(_bit_size);
+        append(escape_token, token_bits);
+        append(static_cast<word_type>(sample.value), Bits);
+    }
+    else
+    {
+        auto diff = static_cast<Unsigned>(sample.value ^ _last.value);
+        if (diff == 0)
+        {
+            append(repeat_token, token_bits);
+        }
+        else if ((diff & (diff - 1u)) == 0)
+        {
+            append(static_cast<word_type>(detail::countr_zero(diff)), token_bits);
+        }
+        else
+        {
+            append(escape_token, token_bits);
+            append(static_cast<word_type>(sample.value), Bits);
+        }
+    }
+    _last = sample;
+    ++_size;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::push(const code_type* samples, size_type count)
+    -> void
+{
+    for (size_type i = 0 ; i < count ; ++i)
+    {
+        push(samples[i]);
+    }
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::clear() noexcept
+    -> void
+{
+    _words.clear();
+    _keyframes.clear();
+    _bit_size = 0;
+    _size = 0;
+    _last = code_type();
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::append(word_type bits, unsigned width)
+    -> void
+{
+    // The bits past the end of the last word are always 0,
+    // so the new bits can be or-ed in place
+    auto offset = static_cast<unsigned>(_bit_size % 64);
+    if (offset == 0)
+    {
+        _words.push_back(0);
+    }
+    _words.back() |= bits << offset;
+    if (offset + width > 64)
+    {
+        _words.push_back(bits >> (64 - offset));
+    }
+    _bit_size += width;
+}
+
+////////////////////////////////////////////////////////////
+// Writer observers
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::size() const noexcept
+    -> size_type
+{
+    return _size;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::keyframe_interval() const noexcept
+    -> size_type
+{
+    return _keyframe_interval;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::bit_size() const noexcept
+    -> std::uint64_t
+{
+    return _bit_size;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::words() const noexcept
+    -> const std::vector<word_type>&
+{
+    return _words;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_writer<Unsigned, Bits>::keyframes() const noexcept
+    -> const std::vector<std::uint64_t>&
+{
+    return _keyframes;
+}
+
+////////////////////////////////////////////////////////////
+// Reader construction
+
+template<typename Unsigned, std::size_t Bits>
+gray_trace_reader<Unsigned, Bits>::gray_trace_reader(const word_type* words, size_type size,
+                                                     const std::uint64_t* keyframes,
+                                                     size_type keyframe_interval) noexcept:
+    _words(words),
+    _keyframes(keyframes),
+    _size(size),
+    _keyframe_interval(keyframe_interval),
+    _position(0),
+    _bit_offset(0),
+    _code(),
+    _value(0)
+{}
+
+template<typename Unsigned, std::size_t Bits>
+gray_trace_reader<Unsigned, Bits>::gray_trace_reader(const gray_trace_writer<Unsigned, Bits>& writer) noexcept:
+    gray_trace_reader(writer.words().data(), writer.size(),
+                      writer.keyframes().data(), writer.keyframe_interval())
+{}
+
+////////////////////////////////////////////////////////////
+// Reading operations
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::next() noexcept
+    -> code_type
+{
+    step();
+    return _code;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::read(value_type* out, size_type count) noexcept
+    -> size_type
+{
+    if (count > _size - _position)
+    {
+        count = _size - _position;
+    }
+    for (size_type i = 0 ; i < count ; ++i)
+    {
+        step();
+        out[i] = _value;
+    }
+    return count;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::seek(size_type index) noexcept
+    -> void
+{
+    if (index == 0)
+    {
+        _position = 0;
+        _bit_offset = 0;
+        _code = code_type();
+        _value = 0;
+        return;
+    }
+
+    // Replay the samples from the keyframe of the sample
+    // before the given one, so that code() and value() are
+    // the same as if the samples had been read in order
+    auto keyframe = (index - 1) / _keyframe_interval;
+    _position = keyframe * _keyframe_interval;
+    _bit_offset = _keyframes[keyframe];
+    while (_position < index)
+    {
+        step();
+    }
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::fetch(unsigned width) noexcept
+    -> word_type
+{
+    auto index = static_cast<size_type>(_bit_offset / 64);
+    auto offset = static_cast<unsigned>(_bit_offset % 64);
+    word_type res = _words[index] >> offset;
+    if (offset + width > 64)
+    {
+        res |= _words[index + 1] << (64 - offset);
+    }
+    if (width < 64)
+    {
+        res &= (word_type(1) << width) - 1u;
+    }
+    _bit_offset += width;
+    return res;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::step() noexcept
+    -> void
+{
+    auto token = fetch(token_bits);
+    if (token < Bits)
+    {
+        // Bit k of the Gray code flipped: flip bits 0 to k
+        // of the position, wrapping around for the top bit
+        _code.value ^= static_cast<Unsigned>(Unsigned(1) << token);
+        auto low_bits = static_cast<value_type>((value_type(2) << token) - 1u);
+        _value ^= static_cast<value_type>(low_bits & code_type::mask);
+    }
+    else if (token == Bits + 1)
+    {
+        _code.value = static_cast<Unsigned>(fetch(Bits));
+        _value = static_cast<value_type>(_code);
+    }
+    ++_position;
+}
+
+////////////////////////////////////////////////////////////
+// Reader observers
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::size() const noexcept
+    -> size_type
+{
+    return _size;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::position() const noexcept
+    -> size_type
+{
+    return _position;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::code() const noexcept
+    -> code_type
+{
+    return _code;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto gray_trace_reader<Unsigned, Bits>::value() const noexcept
+    -> value_type
+{
+    return _value;
+}
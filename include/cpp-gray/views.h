@@ -0,0 +1,154 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPGRAY_VIEWS_H_
+#define CPPGRAY_VIEWS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#if __cplusplus >= 202002L
+#   include <ranges>
+#endif
+#include "gray.h"
+#include "range.h"
+
+#if defined(__cpp_lib_ranges)
+namespace cppgray
+{
+    /**
+     * @brief View of consecutive Gray codes.
+     *
+     * Standard range counterpart of gray_range: the view is lazy,
+     * doesn't allocate and can be used in constant expressions.
+     * It is a sized, common and random access view, and a borrowed
+     * range, so the algorithms of std::ranges can bisect it and the
+     * views of the standard library can be applied to it. Moving
+     * its iterators by any number of positions runs in constant
+     * time, as with gray_iterator.
+     *
+     * The algorithms of std::ranges are sequential: range() gives
+     * the equivalent gray_range to split the view for for_each_slice
+     * or tbb::parallel_for.
+     *
+     * auto codes = views::gray<std::uint32_t>(28)
+     *            | std::views::filter([](auto code) { return is_odd(code); });
+     */
+    template<typename Unsigned>
+    class gray_view:
+        public std::ranges::view_interface<gray_view<Unsigned>>
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using iterator      = gray_iterator<Unsigned>;
+            using value_type    = gray_code<Unsigned>;
+            using position_type = typename iterator::position_type;
+            using size_type     = position_type;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            /**
+             * @brief Empty view.
+             */
+            constexpr gray_view() noexcept;
+
+            /**
+             * @brief View of every Gray code of a given number of bits.
+             *
+             * @param bits Number of bits, no greater than the number of
+             *        bits of Unsigned and lower than 64
+             */
+            constexpr explicit gray_view(std::size_t bits) noexcept;
+
+            /**
+             * @brief View of the Gray codes at positions [first, last).
+             */
+            constexpr gray_view(position_type first, position_type last) noexcept;
+
+            ////////////////////////////////////////////////////////////
+            // Iterators
+
+            constexpr auto begin() const noexcept
+                -> iterator;
+            constexpr auto end() const noexcept
+                -> iterator;
+
+            ////////////////////////////////////////////////////////////
+            // Capacity
+
+            constexpr auto size() const noexcept
+                -> size_type;
+
+            ////////////////////////////////////////////////////////////
+            // Conversion
+
+            /**
+             * @brief gray_range covering the same Gray codes.
+             *
+             * @param grain_size Size under which the range can't be split
+             */
+            constexpr auto range(size_type grain_size = 1) const noexcept
+                -> gray_range<Unsigned>;
+
+        private:
+
+            position_type _first;
+            position_type _last;
+    };
+
+    namespace views
+    {
+        /**
+         * @brief View of every Gray code of a given number of bits.
+         *
+         * @param bits Number of bits, no greater than the number of
+         *        bits of Unsigned and lower than 64
+         */
+        template<typename Unsigned = std::uint64_t>
+        constexpr auto gray(std::size_t bits) noexcept
+            -> gray_view<Unsigned>;
+
+        /**
+         * @brief View of the Gray codes at positions [first, last).
+         */
+        template<typename Unsigned = std::uint64_t>
+        constexpr auto gray(std::uint64_t first, std::uint64_t last) noexcept
+            -> gray_view<Unsigned>;
+    }
+
+    #include "views.inl"
+}
+
+// The iterators don't refer to the view
+template<typename Unsigned>
+inline constexpr bool std::ranges::enable_borrowed_range<cppgray::gray_view<Unsigned>> = true;
+#endif
+
+#endif // CPPGRAY_VIEWS_H_
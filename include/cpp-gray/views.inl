@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// gray_view construction
+
+template<typename Unsigned>
+constexpr gray_view<Unsigned>::gray_view() noexcept:
+    _first(0),
+    _last(0)
+{}
+
+template<typename Unsigned>
+constexpr gray_view<Unsigned>::gray_view(std::size_t bits) noexcept:
+    _first(0),
+    _last(position_type(1) << bits)
+{}
+
+template<typename Unsigned>
+constexpr gray_view<Unsigned>::gray_view(position_type first, position_type last) noexcept:
+    _first(first),
+    _last(last)
+{}
+
+////////////////////////////////////////////////////////////
+// gray_view iterators
+
+template<typename Unsigned>
+constexpr auto gray_view<Unsigned>::begin() const noexcept
+    -> iterator
+{
+    return iterator(_first);
+}
+
+template<typename Unsigned>
+constexpr auto gray_view<Unsigned>::end() const noexcept
+    -> iterator
+{
+    return iterator(_last);
+}
+
+////////////////////////////////////////////////////////////
+// gray_view capacity
+
+template<typename Unsigned>
+constexpr auto gray_view<Unsigned>::size() const noexcept
+    -> size_type
+{
+    return _last - _first;
+}
+
+////////////////////////////////////////////////////////////
+// gray_view conversion
+
+template<typename Unsigned>
+constexpr auto gray_view<Unsigned>::range(size_type grain_size) const noexcept
+    -> gray_range<Unsigned>
+{
+    return gray_range<Unsigned>(_first, _last, grain_size);
+}
+
+////////////////////////////////////////////////////////////
+// Range factories
+
+namespace views
+{
+    template<typename Unsigned>
+    constexpr auto gray(std::size_t bits) noexcept
+        -> gray_view<Unsigned>
+    {
+        return gray_view<Unsigned>(bits);
+    }
+
+    template<typename Unsigned>
+    constexpr auto gray(std::uint64_t first, std::uint64_t last) noexcept
+        -> gray_view<Unsigned>
+    {
+        return gray_view<Unsigned>(first, last);
+    }
+}
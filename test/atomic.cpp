@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <cpp-gray/atomic.h>
+
+int main()
+{
+    using namespace cppgray;
+
+    ////////////////////////////////////////////////////////////
+    // Sequential operations
+
+    {
+        atomic_gray_code<std::uint8_t> counter;
+        assert(counter.load() == gray(std::uint8_t(0)));
+        assert(counter.increment() == gray(std::uint8_t(1)));
+        assert(counter.single_writer_increment() == gray(std::uint8_t(2)));
+        assert(counter.decrement() == gray(std::uint8_t(1)));
+        assert(counter.load_value() == 1u);
+
+        // Circular behaviour on overflow
+        counter.store(gray(std::uint8_t(255)));
+        assert(counter.increment().value == 0u);
+        assert(counter.decrement() == gray(std::uint8_t(255)));
+
+        atomic_gray_code<std::uint16_t, 12> narrow(gray_code<std::uint16_t, 12>(std::uint16_t(4095)));
+        assert(narrow.increment().value == 0u);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Concurrent writers
+
+    {
+        constexpr int threads = 4;
+        constexpr int increments = 20000;
+
+        atomic_gray_code<std::uint32_t> counter;
+        std::vector<std::thread> writers;
+        for (int i = 0 ; i < threads ; ++i)
+        {
+            writers.emplace_back([&] {
+                for (int j = 0 ; j < increments ; ++j)
+                {
+                    counter.increment();
+                }
+            });
+        }
+        for (auto& writer: writers)
+        {
+            writer.join();
+        }
+        assert(counter.load_value() == threads * increments);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Single writer with a concurrent reader
+
+    {
+        constexpr std::uint32_t increments = 100000;
+
+        atomic_gray_code<std::uint32_t> counter;
+        std::atomic<bool> done(false);
+        std::thread writer([&] {
+            for (std::uint32_t i = 0 ; i < increments ; ++i)
+            {
+                counter.single_writer_increment(std::memory_order_release);
+            }
+            done = true;
+        });
+
+        // The reader never sees the counter go backward
+        std::uint32_t previous = 0;
+        while (not done)
+        {
+            std::uint32_t current = counter.load_value(std::memory_order_acquire);
+            assert(current >= previous);
+            previous = current;
+        }
+        writer.join();
+        assert(counter.load_value() == increments);
+    }
+}
@@ -0,0 +1,389 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#define CPPGRAY_USE_EXECUTION_POLICIES
+#include <cpp-gray/batch.h>
+
+// Deterministic pseudo-random values covering every bit
+template<typename Unsigned>
+auto make_values(std::size_t size)
+    -> std::vector<Unsigned>
+{
+    std::vector<Unsigned> res(size);
+    std::uint64_t state = 0x9e3779b97f4a7c15u;
+    for (auto& value: res)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        value = static_cast<Unsigned>(state);
+    }
+    if (size > 1)
+    {
+        res[0] = 0u;
+        res[1] = std::numeric_limits<Unsigned>::max();
+    }
+    return res;
+}
+
+template<typename Unsigned>
+auto test_conversions()
+    -> void
+{
+    using namespace cppgray;
+
+    // Sizes around the vector widths to check the scalar tails
+    for (std::size_t size: { 0u, 1u, 7u, 16u, 33u, 64u, 1031u })
+    {
+        auto values = make_values<Unsigned>(size);
+
+        std::vector<gray_code<Unsigned>> codes(size);
+        encode(values.data(), codes.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(codes[i] == gray(values[i]));
+        }
+
+        std::vector<Unsigned> decoded(size);
+        decode(codes.data(), decoded.data(), size);
+        assert(decoded == values);
+
+        // In-place conversion
+        std::vector<gray_code<Unsigned>> in_place(size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            in_place[i].value = values[i];
+        }
+        auto ptr = reinterpret_cast<Unsigned*>(in_place.data());
+        encode(ptr, in_place.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(in_place[i] == codes[i]);
+        }
+        decode(in_place.data(), ptr, size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(in_place[i].value == values[i]);
+        }
+    }
+}
+
+template<typename Unsigned>
+auto test_parity()
+    -> void
+{
+    using namespace cppgray;
+
+    for (std::size_t size: { 0u, 1u, 7u, 16u, 33u, 64u, 1031u })
+    {
+        auto values = make_values<Unsigned>(size);
+        std::vector<gray_code<Unsigned>> codes(size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            codes[i].value = values[i];
+        }
+
+        std::unique_ptr<bool[]> odd(new bool[size + 1]);
+        std::unique_ptr<bool[]> even(new bool[size + 1]);
+        is_odd(codes.data(), odd.get(), size);
+        is_even(codes.data(), even.get(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            // Count the bits one by one to get a reference
+            bool parity = false;
+            for (Unsigned value = values[i] ; value ; value >>= 1)
+            {
+                parity ^= static_cast<bool>(value & 1u);
+            }
+            assert(odd[i] == parity);
+            assert(even[i] != parity);
+        }
+    }
+}
+
+// Gray codes narrower than their underlying type
+template<typename Unsigned, std::size_t Bits>
+auto test_sub_word()
+    -> void
+{
+    using namespace cppgray;
+    constexpr auto mask = gray_code<Unsigned, Bits>::mask;
+
+    for (std::size_t size: { 0u, 1u, 7u, 16u, 33u, 64u, 1031u })
+    {
+        auto values = make_values<Unsigned>(size);
+
+        // Encoding drops the bits above the width
+        std::vector<gray_code<Unsigned, Bits>> codes(size);
+        encode(values.data(), codes.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert((codes[i] == gray_code<Unsigned, Bits>(values[i])));
+            assert((codes[i].value & ~mask) == 0u);
+        }
+
+        std::vector<Unsigned> decoded(size);
+        decode(codes.data(), decoded.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(decoded[i] == (values[i] & mask));
+        }
+    }
+}
+
+#if defined(__cpp_lib_execution)
+// Buffers spanning several parallel chunks
+template<typename Unsigned, typename ExecutionPolicy>
+auto test_parallel(ExecutionPolicy&& policy)
+    -> void
+{
+    using namespace cppgray;
+
+    for (std::size_t size: { 0u, 1031u, 300001u, 1000003u })
+    {
+        auto values = make_values<Unsigned>(size);
+
+        std::vector<gray_code<Unsigned>> codes(size);
+        encode(policy, values.data(), codes.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(codes[i] == gray(values[i]));
+        }
+
+        std::vector<Unsigned> decoded(size);
+        decode(policy, codes.data(), decoded.data(), size);
+        assert(decoded == values);
+    }
+}
+#endif
+
+template<typename Unsigned, std::size_t Bits>
+auto test_increment()
+    -> void
+{
+    using namespace cppgray;
+    constexpr auto mask = gray_code<Unsigned, Bits>::mask;
+
+    for (std::size_t size: { 0u, 1u, 7u, 16u, 33u, 64u, 1031u })
+    {
+        // Raw Gray codes, including 0 and the last code of
+        // the sequence to check the wraparound
+        auto values = make_values<Unsigned>(size);
+        std::vector<gray_code<Unsigned, Bits>> codes(size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            codes[i].value = static_cast<Unsigned>(values[i] & mask);
+        }
+        if (size > 2)
+        {
+            codes[2] = gray_code<Unsigned, Bits>(mask);
+        }
+
+        auto incremented = codes;
+        increment(incremented.data(), size);
+        auto decremented = codes;
+        decrement(decremented.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            auto code = codes[i];
+            assert(incremented[i] == ++code);
+            code = codes[i];
+            assert(decremented[i] == --code);
+        }
+    }
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto test_generation()
+    -> void
+{
+    using namespace cppgray;
+    constexpr auto max = std::numeric_limits<Unsigned>::max();
+    constexpr auto mask = gray_code<Unsigned, Bits>::mask;
+
+    for (std::size_t size: { 0u, 1u, 7u, 16u, 33u, 64u, 1031u })
+    {
+        // Starts close to the end of the sequence and of the
+        // underlying type to check the wraparounds
+        for (Unsigned start: { Unsigned(0), Unsigned(5),
+                               static_cast<Unsigned>(mask - 20u),
+                               static_cast<Unsigned>(max - 40u) })
+        {
+            std::vector<gray_code<Unsigned, Bits>> codes(size);
+            generate_gray(start, size, codes.data());
+            auto code = gray_code<Unsigned, Bits>(start);
+            for (std::size_t i = 0 ; i < size ; ++i)
+            {
+                assert(codes[i] == code);
+                ++code;
+            }
+
+            // Every flip goes from a Gray code of the underlying
+            // type to the next one
+            std::vector<gray_code<Unsigned>> full(size + 1);
+            generate_gray(start, size + 1, full.data());
+            std::vector<std::uint8_t> flips(size);
+            generate_flips(start, size, flips.data());
+            for (std::size_t i = 0 ; i < size ; ++i)
+            {
+                assert(flips[i] < std::numeric_limits<Unsigned>::digits);
+                assert((full[i].value ^ full[i + 1].value) == (Unsigned(1) << flips[i]));
+            }
+        }
+    }
+}
+
+template<typename Unsigned>
+auto test_neighbours()
+    -> void
+{
+    using namespace cppgray;
+    constexpr auto digits = std::numeric_limits<Unsigned>::digits;
+
+    for (std::size_t size: { 0u, 1u, 7u, 16u, 33u, 64u, 1031u })
+    {
+        // Sparse differences from the query so that every
+        // radius matches some of the codes
+        auto values = make_values<Unsigned>(size);
+        auto query = gray_code<Unsigned>(static_cast<Unsigned>(0x5a5a5a5a5a5a5a5au));
+        std::vector<gray_code<Unsigned>> codes(size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            auto flips = static_cast<Unsigned>(values[i] & (values[i] >> 1) & (values[i] >> 2));
+            codes[i].value = static_cast<Unsigned>(query.value ^ flips);
+        }
+
+        std::vector<std::uint8_t> distances(size);
+        hamming_distance(query, codes.data(), distances.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(distances[i] == hamming_distance(query, codes[i]));
+        }
+
+        std::vector<std::size_t> indices(size);
+        for (std::size_t radius: { 0, 1, 2, 3, 5, digits / 2, digits, digits + 10 })
+        {
+            auto count = find_within(query, radius, codes.data(), size, indices.data());
+            std::size_t expected = 0;
+            for (std::size_t i = 0 ; i < size ; ++i)
+            {
+                if (distances[i] <= radius)
+                {
+                    assert(expected < count && indices[expected] == i);
+                    ++expected;
+                }
+            }
+            assert(count == expected);
+        }
+    }
+}
+
+int main()
+{
+    ////////////////////////////////////////////////////////////
+    // Batch conversions for every unsigned integer width
+
+    test_conversions<unsigned char>();
+    test_conversions<unsigned short>();
+    test_conversions<unsigned int>();
+    test_conversions<unsigned long>();
+    test_conversions<unsigned long long>();
+#if defined(CPPGRAY_HAS_INT128)
+    test_conversions<cppgray::detail::uint128_type>();
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Batch parity for every unsigned integer width
+
+    test_parity<unsigned char>();
+    test_parity<unsigned short>();
+    test_parity<unsigned int>();
+    test_parity<unsigned long>();
+    test_parity<unsigned long long>();
+#if defined(CPPGRAY_HAS_INT128)
+    test_parity<cppgray::detail::uint128_type>();
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Batch Hamming distances
+
+    test_neighbours<unsigned char>();
+    test_neighbours<unsigned short>();
+    test_neighbours<unsigned int>();
+    test_neighbours<unsigned long long>();
+#if defined(CPPGRAY_HAS_INT128)
+    test_neighbours<cppgray::detail::uint128_type>();
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Batch increments and decrements
+
+    test_increment<unsigned char, 8>();
+    test_increment<unsigned char, 5>();
+    test_increment<unsigned short, 16>();
+    test_increment<unsigned short, 12>();
+    test_increment<unsigned int, 32>();
+    test_increment<unsigned int, 1>();
+    test_increment<unsigned long long, 64>();
+    test_increment<unsigned long long, 40>();
+
+    ////////////////////////////////////////////////////////////
+    // Batch generation of consecutive Gray codes
+
+    test_generation<unsigned char, 8>();
+    test_generation<unsigned char, 5>();
+    test_generation<unsigned short, 16>();
+    test_generation<unsigned short, 12>();
+    test_generation<unsigned int, 32>();
+    test_generation<unsigned int, 17>();
+    test_generation<unsigned long long, 64>();
+    test_generation<unsigned long long, 40>();
+#if defined(CPPGRAY_HAS_INT128)
+    test_generation<cppgray::detail::uint128_type, 128>();
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Batch conversions for sub-word Gray codes
+
+    test_sub_word<unsigned char, 5>();
+    test_sub_word<unsigned short, 12>();
+    test_sub_word<unsigned int, 17>();
+    test_sub_word<unsigned long long, 33>();
+    test_sub_word<unsigned long long, 48>();
+
+#if defined(__cpp_lib_execution)
+    ////////////////////////////////////////////////////////////
+    // Parallel batch conversions
+
+    test_parallel<unsigned char>(std::execution::par);
+    test_parallel<unsigned int>(std::execution::par);
+    test_parallel<unsigned long long>(std::execution::par_unseq);
+    test_parallel<unsigned short>(std::execution::seq);
+#endif
+}
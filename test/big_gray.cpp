@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cpp-gray/big_gray.h>
+
+// Bit by bit conversions used as a reference
+
+template<std::size_t Bits>
+auto reference_encode(const std::bitset<Bits>& bits)
+    -> std::bitset<Bits>
+{
+    return bits ^ (bits >> 1);
+}
+
+template<std::size_t Bits>
+auto reference_decode(const std::bitset<Bits>& bits)
+    -> std::bitset<Bits>
+{
+    std::bitset<Bits> res;
+    bool parity = false;
+    for (std::size_t i = Bits ; i-- > 0 ;)
+    {
+        parity ^= bits[i];
+        res[i] = parity;
+    }
+    return res;
+}
+
+template<std::size_t Bits>
+auto to_bitset(const typename cppgray::big_gray_code<Bits>::binary_type& words)
+    -> std::bitset<Bits>
+{
+    std::bitset<Bits> res;
+    for (std::size_t i = 0 ; i < Bits ; ++i)
+    {
+        res[i] = (words[i / 64] >> (i % 64)) & 1;
+    }
+    return res;
+}
+
+template<std::size_t Bits>
+auto test_conversions()
+    -> void
+{
+    using namespace cppgray;
+    using code_type = big_gray_code<Bits>;
+
+    std::uint64_t state = 0x9e3779b97f4a7c15u;
+    for (int n = 0 ; n < 100 ; ++n)
+    {
+        typename code_type::binary_type binary;
+        for (auto& word: binary)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            word = state;
+        }
+        if (n == 0)
+        {
+            // Every bit set: alternating carries
+            for (auto& word: binary)
+            {
+                word = ~std::uint64_t(0);
+            }
+        }
+        binary[code_type::words - 1] &= code_type::top_mask;
+        auto bits = to_bitset<Bits>(binary);
+
+        code_type code(binary);
+        assert(static_cast<std::bitset<Bits>>(code) == reference_encode(bits));
+        assert(code.to_binary() == binary);
+        assert(is_odd(code) == (reference_encode(bits).count() % 2 == 1));
+        assert(is_even(code) != is_odd(code));
+
+        // Raw bits are decoded like any other Gray code
+        code_type raw(bits);
+        assert(raw.value == binary);
+        assert(to_bitset<Bits>(raw.to_binary()) == reference_decode(bits));
+    }
+
+    // Bits beyond the width are ignored
+    typename code_type::binary_type ones;
+    for (auto& word: ones)
+    {
+        word = ~std::uint64_t(0);
+    }
+    code_type code(ones);
+    assert((code.value[code_type::words - 1] & ~code_type::top_mask) == 0);
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    ////////////////////////////////////////////////////////////
+    // Cross-word carries
+
+    {
+        // Single bit in the upper word
+        big_gray_code<128>::binary_type binary = {{ 0, 1 }};
+        big_gray_code<128> code(binary);
+        assert(code.value[0] == 0x8000000000000000u);
+        assert(code.value[1] == 1u);
+        assert(code.to_binary() == binary);
+
+        big_gray_code<128> other;
+        assert(other != code);
+        swap(other, code);
+        assert(other.to_binary() == binary);
+        assert(code == big_gray_code<128>());
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Conversions against the bit by bit reference
+
+    test_conversions<1>();
+    test_conversions<64>();
+    test_conversions<100>();
+    test_conversions<128>();
+    test_conversions<256>();
+    test_conversions<1000>();
+    test_conversions<1024>();
+}
@@ -0,0 +1,177 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include <cpp-gray/combination.h>
+#include <cpp-gray/range.h>
+
+constexpr auto revolving_door()
+    -> bool
+{
+    using namespace cppgray;
+
+    // 0b0011, 0b0110, 0b0101, 0b1100, 0b1010, 0b1001
+    revolving_door_range<unsigned> range(4, 2);
+    bool res = range.size() == 6u;
+
+    auto it = range.begin();
+    res = res && (*it).value == 0x3u && it.added_bit() == 64 && it.removed_bit() == 64;
+    ++it;
+    res = res && (*it).value == 0x6u && it.added_bit() == 2 && it.removed_bit() == 0;
+    ++it;
+    res = res && (*it).value == 0x5u && it.added_bit() == 0 && it.removed_bit() == 1;
+    ++it;
+    res = res && (*it).value == 0xcu && it.added_bit() == 3 && it.removed_bit() == 0;
+    ++it;
+    res = res && (*it).value == 0xau && it.added_bit() == 1 && it.removed_bit() == 2;
+    ++it;
+    res = res && (*it).value == 0x9u && it.added_bit() == 0 && it.removed_bit() == 1;
+    ++it;
+    res = res && it == range.end();
+
+    // The codes are returned by value, so copies of the
+    // earlier ones don't change when the iterator moves
+    auto other = range.begin();
+    auto first = *other;
+    ++other;
+    auto second = *other;
+    ++other;
+    res = res && first.value == 0x3u && second.value == 0x6u && (*other).value == 0x5u;
+
+    res = res && detail::binomial(64, 32) == 1832624140942590534u;
+    res = res && revolving_door_range<unsigned>(5, 0).size() == 1u;
+    res = res && revolving_door_range<unsigned>(5, 5).size() == 1u;
+
+    return res;
+}
+
+// The revolving-door sequence is the subsequence of the
+// Gray codes of n bits whose codes have k bits set
+auto check(std::size_t n, std::size_t k)
+    -> void
+{
+    using namespace cppgray;
+
+    std::vector<std::uint32_t> expected;
+    for (auto code: gray_range<std::uint32_t>(n))
+    {
+        if (std::bitset<32>(code.value).count() == k)
+        {
+            expected.push_back(code.value);
+        }
+    }
+
+    revolving_door_range<std::uint32_t> range(n, k);
+    assert(range.size() == expected.size());
+
+    std::size_t i = 0;
+    std::uint32_t prev = 0;
+    for (auto it = range.begin() ; it != range.end() ; ++it, ++i)
+    {
+        assert((*it).value == expected[i]);
+        assert(it.position() == i);
+        if (i > 0)
+        {
+            assert((prev >> it.removed_bit() & 1u) == 1u);
+            assert((prev >> it.added_bit() & 1u) == 0u);
+            assert((prev ^ (*it).value) == ((1u << it.added_bit()) | (1u << it.removed_bit())));
+        }
+        prev = (*it).value;
+    }
+    assert(i == expected.size());
+
+    // Applying the exchanges reproduces the sequence
+    std::uint32_t subset = expected[0];
+    std::size_t steps = 0;
+    for_each_revolving_door_swap(n, k, [&](int added, int removed) {
+        subset ^= (1u << added) | (1u << removed);
+        ++steps;
+        assert(subset == expected[steps]);
+    });
+    assert(steps + 1 == expected.size());
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    static_assert(revolving_door(), "");
+#if defined(__cpp_lib_ranges)
+    static_assert(std::forward_iterator<revolving_door_iterator<unsigned>>);
+#endif
+
+    {
+        // Dereferencing a temporary iterator doesn't dangle
+        revolving_door_range<unsigned> range(4, 2);
+        const auto& code = *std::next(range.begin());
+        assert(code.value == 0x6u);
+    }
+
+    for (std::size_t n = 0 ; n <= 14 ; ++n)
+    {
+        for (std::size_t k = 0 ; k <= n ; ++k)
+        {
+            check(n, k);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Every bit of a 64-bit type
+
+    {
+        std::uint64_t count = 0;
+        std::uint64_t subset = 3;
+        for (auto code: revolving_door_range<std::uint64_t>(64, 2))
+        {
+            assert(count == 0 || std::bitset<64>(code.value ^ subset).count() == 2u);
+            assert(std::bitset<64>(code.value).count() == 2u);
+            subset = code.value;
+            ++count;
+        }
+        assert(count == 2016u);
+
+        auto it = revolving_door_range<std::uint64_t>(64, 63).begin();
+        assert((*it).value == 0x7fffffffffffffffu);
+        ++it;
+        assert(std::bitset<64>((*it).value).count() == 63u);
+        assert(it.added_bit() == 63);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Small unsigned types
+
+    {
+        std::size_t count = 0;
+        for (auto code: revolving_door_range<std::uint8_t>(8, 3))
+        {
+            assert(std::bitset<8>(code.value).count() == 3u);
+            ++count;
+        }
+        assert(count == 56u);
+    }
+}
@@ -0,0 +1,159 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#define CPPGRAY_RUNTIME_DISPATCH
+#include <cpp-gray/batch.h>
+
+template<typename Unsigned>
+auto make_values(std::size_t size)
+    -> std::vector<Unsigned>
+{
+    std::vector<Unsigned> res(size);
+    std::uint64_t state = 0x9e3779b97f4a7c15u;
+    for (auto& value: res)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        value = static_cast<Unsigned>(state);
+    }
+    res[0] = 0u;
+    res[1] = std::numeric_limits<Unsigned>::max();
+    return res;
+}
+
+template<typename Unsigned, std::size_t Bits>
+auto test_batch()
+    -> void
+{
+    using namespace cppgray;
+    using code_type = gray_code<Unsigned, Bits>;
+
+    // Odd size to exercise the scalar tail as well
+    constexpr std::size_t size = 1000 + 7;
+    auto values = make_values<Unsigned>(size);
+
+    std::vector<code_type> codes(size);
+    encode(values.data(), codes.data(), size);
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        assert(codes[i] == code_type(values[i]));
+    }
+
+    std::vector<Unsigned> decoded(size);
+    decode(codes.data(), decoded.data(), size);
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        assert(decoded[i] == static_cast<Unsigned>(codes[i]));
+    }
+
+    std::vector<char> parity(size);
+    bool* out = reinterpret_cast<bool*>(parity.data());
+    is_odd(codes.data(), out, size);
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        assert(out[i] == is_odd(codes[i]));
+    }
+    is_even(codes.data(), out, size);
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        assert(out[i] == is_even(codes[i]));
+    }
+
+    auto steps = codes;
+    increment(steps.data(), size);
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        assert(steps[i] == successor(codes[i]));
+    }
+    decrement(steps.data(), size);
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        assert(steps[i] == codes[i]);
+    }
+}
+
+#if defined(CPPGRAY_SIMD_DISPATCH)
+// Every version of a kernel supported by the CPU gives
+// the same results as the scalar code
+template<typename Unsigned>
+auto test_versions()
+    -> void
+{
+    using namespace cppgray;
+    using dispatcher = detail::dispatcher<detail::encode_op<std::numeric_limits<Unsigned>::digits>,
+                                          std::size_t(const Unsigned*, Unsigned*, std::size_t)>;
+
+    constexpr std::size_t size = 517;
+    auto values = make_values<Unsigned>(size);
+    std::vector<Unsigned> out(size);
+
+    auto check = [&](typename dispatcher::function_type func) {
+        std::size_t done = func(values.data(), out.data(), size);
+        assert(done <= size);
+        for (std::size_t i = 0 ; i < done ; ++i)
+        {
+            assert(out[i] == static_cast<Unsigned>(values[i] ^ (values[i] >> 1)));
+        }
+    };
+
+    auto level = detail::runtime_simd_level();
+    check(dispatcher::select(detail::simd_level::sse2));
+    if (level >= detail::simd_level::avx2)
+    {
+        check(dispatcher::select(detail::simd_level::avx2));
+    }
+    if (level >= detail::simd_level::avx512)
+    {
+        check(dispatcher::select(detail::simd_level::avx512));
+    }
+
+    // The pointer is bound once the kernel has been called
+    encode(values.data(), reinterpret_cast<gray_code<Unsigned>*>(out.data()), size);
+    assert(dispatcher::kernel.load() == dispatcher::select(level));
+}
+#endif
+
+int main()
+{
+    test_batch<std::uint8_t, 8>();
+    test_batch<std::uint16_t, 16>();
+    test_batch<std::uint16_t, 12>();
+    test_batch<std::uint32_t, 32>();
+    test_batch<std::uint32_t, 17>();
+    test_batch<std::uint64_t, 64>();
+    test_batch<std::uint64_t, 40>();
+
+
+#if defined(CPPGRAY_SIMD_DISPATCH)
+    test_versions<std::uint8_t>();
+    test_versions<std::uint16_t>();
+    test_versions<std::uint32_t>();
+    test_versions<std::uint64_t>();
+#endif
+}
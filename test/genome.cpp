@@ -0,0 +1,178 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <cpp-gray/genome.h>
+
+auto random_words(std::size_t size)
+    -> std::vector<std::uint64_t>
+{
+    std::vector<std::uint64_t> res(size);
+    std::uint64_t state = 0x9e3779b97f4a7c15u;
+    for (auto& word: res)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        word = state;
+    }
+    return res;
+}
+
+// Reads the bits of a field one at a time
+auto naive_extract(const std::uint64_t* genome, std::size_t offset, std::size_t bits)
+    -> std::uint64_t
+{
+    std::uint64_t res = 0;
+    for (std::size_t i = 0 ; i < bits ; ++i)
+    {
+        std::size_t pos = offset + i;
+        res |= ((genome[pos / 64] >> (pos % 64)) & 1u) << i;
+    }
+    return res;
+}
+
+auto naive_decode(std::uint64_t code)
+    -> std::uint64_t
+{
+    std::uint64_t res = 0;
+    for (int i = 63 ; i >= 0 ; --i)
+    {
+        std::uint64_t above = i == 63 ? 0u : (res >> (i + 1)) & 1u;
+        res |= (((code >> i) & 1u) ^ above) << i;
+    }
+    return res;
+}
+
+// x87 arithmetic may keep more precision than double
+auto close(double lhs, double rhs)
+    -> bool
+{
+    return std::fabs(lhs - rhs) <= 1e-12 * (std::fabs(rhs) + 1.0);
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    ////////////////////////////////////////////////////////////
+    // Decoding against the reference
+
+    {
+        genome_codec codec = {
+            { 12, -5.0, 5.0 },
+            { 1, 0.0, 1.0 },
+            { 33, -1.0, 1.0 },
+            { 64, 0.0, 1.0 },
+            { 20, 100.0, 200.0 },
+            { 31, -1e6, 1e6 },
+            { 7, 0.0, 127.0 }
+        };
+        assert(codec.fields() == 7u);
+        assert(codec.bits() == 168u);
+        assert(codec.words() == 3u);
+
+        // Odd count so that the last chunk is partial
+        constexpr std::size_t count = 1000;
+        auto population = random_words(count * codec.words());
+        std::vector<double> values(codec.fields() * count);
+        codec.decode(population.data(), count, values.data());
+
+        for (std::size_t i = 0 ; i < count ; ++i)
+        {
+            const std::uint64_t* genome = population.data() + i * codec.words();
+            std::size_t offset = 0;
+            for (std::size_t f = 0 ; f < codec.fields() ; ++f)
+            {
+                auto field = codec.field(f);
+                auto code = naive_extract(genome, offset, field.bits);
+                auto steps = std::ldexp(1.0, static_cast<int>(field.bits)) - 1.0;
+                auto expected = field.min + static_cast<double>(naive_decode(code)) *
+                                ((field.max - field.min) / steps);
+                assert(close(values[f * count + i], expected));
+                assert(close(codec.decode_field(genome, f), expected));
+                offset += field.bits;
+            }
+        }
+
+        // The 7-bit field maps to integers
+        for (std::size_t i = 0 ; i < count ; ++i)
+        {
+            double value = values[6 * count + i];
+            assert(value == std::floor(value) && value >= 0.0 && value <= 127.0);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Encoding back
+
+    {
+        genome_codec codec = {
+            { 10, -1.0, 1.0 },
+            { 40, 0.0, 1e3 },
+            { 5, 3.0, 34.0 },
+            { 17, -2.5, 0.0 }
+        };
+        assert(codec.bits() == 72u);
+
+        constexpr std::size_t count = 777;
+        auto population = random_words(count * codec.words());
+        std::vector<double> values(codec.fields() * count);
+        codec.decode(population.data(), count, values.data());
+
+        std::vector<std::uint64_t> encoded(population.size());
+        codec.encode(values.data(), count, encoded.data());
+        for (std::size_t i = 0 ; i < count ; ++i)
+        {
+            // The bits past the last field are cleared
+            assert(encoded[2 * i] == population[2 * i]);
+            assert(encoded[2 * i + 1] == (population[2 * i + 1] & 0xffu));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Rounding and clamping
+
+    {
+        genome_codec codec = { { 4, 0.0, 15.0 } };
+        const double values[] = {
+            -3.0, 0.0, 0.4, 0.6, 7.0, 14.5, 15.0, 16.0,
+            std::numeric_limits<double>::quiet_NaN(),
+            std::numeric_limits<double>::infinity()
+        };
+        const std::uint64_t expected[] = { 0, 0, 0, 1, 7, 15, 15, 15, 0, 15 };
+
+        constexpr std::size_t count = sizeof values / sizeof values[0];
+        std::uint64_t genomes[count];
+        codec.encode(values, count, genomes);
+        for (std::size_t i = 0 ; i < count ; ++i)
+        {
+            assert(genomes[i] == gray(expected[i]).value);
+        }
+    }
+}
@@ -21,6 +21,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <bitset>
+#include <cassert>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -104,6 +106,62 @@ constexpr auto assignment()
     return res;
 }
 
+constexpr auto arithmetic()
+    -> std::uint64_t
+{
+    using namespace cppgray;
+
+    std::uint64_t res = 0u;
+    std::size_t pos = 0u;
+
+    ////////////////////////////////////////////////////////////
+    // Arithmetic assignment operators
+
+    {
+        auto gr = gray(1000u);
+        gr += 24u;
+        res |= check(gr == 1024u, pos++);
+        gr -= gray(1023u);
+        res |= check(gr == 1u, pos++);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // advance function
+
+    {
+        auto gr = gray(58u);
+        advance(gr, 6);
+        res |= check(gr == 64u, pos++);
+        advance(gr, -65);
+        res |= check(gr == std::numeric_limits<unsigned>::max(), pos++);
+    }
+
+    return res;
+}
+
+template<typename Unsigned>
+constexpr auto ordering(Unsigned first, Unsigned last)
+    -> bool
+{
+    using namespace cppgray;
+
+    // Compare every pair of Gray codes in [first, last)
+    // with the order of the corresponding integers
+    for (Unsigned i = first ; i != last ; ++i)
+    {
+        for (Unsigned j = first ; j != last ; ++j)
+        {
+            auto gi = gray(i);
+            auto gj = gray(j);
+            if ((gi < gj) != (i < j)) return false;
+            if ((gi <= gj) != (i <= j)) return false;
+            if ((gi > gj) != (i > j)) return false;
+            if ((gi >= gj) != (i >= j)) return false;
+        }
+    }
+    return true;
+}
+
 constexpr auto increment()
     -> std::uint64_t
 {
@@ -172,6 +230,134 @@ constexpr auto increment()
     return res;
 }
 
+constexpr auto sub_word()
+    -> std::uint64_t
+{
+    using namespace cppgray;
+    using gray12 = gray_code<std::uint16_t, 12>;
+    using u16 = std::uint16_t;
+
+    std::uint64_t res = 0u;
+    std::size_t pos = 0u;
+
+    ////////////////////////////////////////////////////////////
+    // Construction keeps the bits of the width only
+
+    {
+        gray12 gr(u16(0xf123u));
+        res |= check(gr == u16(0x123u), pos++);
+        res |= check(gr.value == (0x123u ^ (0x123u >> 1)), pos++);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Circular behaviour on the width of the code
+
+    {
+        gray12 gr(u16(4095u));
+        ++gr;
+        res |= check(gr.value == 0u, pos++);
+        --gr;
+        res |= check(gr == u16(4095u), pos++);
+        res |= check(gr.value == 0x800u, pos++);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Bitwise operations stay within the width
+
+    {
+        gray12 gr;
+        gr = ~gr;
+        res |= check(gr.value == 0xfffu, pos++);
+        gr <<= 4u;
+        res |= check(gr.value == 0xff0u, pos++);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Arithmetic wraps around the width
+
+    {
+        gray12 gr(u16(4000u));
+        gr += u16(100u);
+        res |= check(gr == u16(4u), pos++);
+        res |= check(distance(gray12(u16(4000u)), gr) == 100, pos++);
+        res |= check(distance(gr, gray12(u16(4000u))) == -100, pos++);
+    }
+
+    return res;
+}
+
+#if defined(CPPGRAY_HAS_INT128)
+constexpr auto wide()
+    -> std::uint64_t
+{
+    using namespace cppgray;
+    using u128 = detail::uint128_type;
+
+    std::uint64_t res = 0u;
+    std::size_t pos = 0u;
+
+    constexpr u128 max = ~u128(0);
+    constexpr u128 high = u128(0xdeadbeefcafebabeu) << 64;
+
+    ////////////////////////////////////////////////////////////
+    // Conversions across the two 64-bit halves
+
+    {
+        auto gr = gray(high | 42u);
+        res |= check(static_cast<u128>(gr) == (high | 42u), pos++);
+        res |= check(gr.value == ((high | 42u) ^ ((high | 42u) >> 1)), pos++);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Circular behaviour on overflow
+
+    {
+        auto gr = gray(max);
+        ++gr;
+        res |= check(gr.value == 0u, pos++);
+        --gr;
+        res |= check(gr == max, pos++);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parity, ordering and distance
+
+    {
+        res |= check(is_odd(gray(max)), pos++);
+        res |= check(is_even(gray(high)), pos++);
+        res |= check(gray(high) < gray(high | 1u), pos++);
+        res |= check(gray(u128(1) << 64) > gray(~u128(0) >> 64), pos++);
+        res |= check(distance(gray(high), gray(u128(5))) == -detail::int128_type(high - 5u), pos++);
+    }
+
+    return res;
+}
+#endif
+
+template<typename Unsigned, std::size_t Bits>
+constexpr auto steps()
+    -> bool
+{
+    using namespace cppgray;
+    using code_type = gray_code<Unsigned, Bits>;
+
+    // Compare successor and predecessor with the Gray codes
+    // of the next and previous integers for every code
+    constexpr Unsigned mask = code_type::mask;
+    for (unsigned i = 0 ; i <= mask ; ++i)
+    {
+        auto value = static_cast<Unsigned>(i);
+        auto next = static_cast<Unsigned>((i + 1) & mask);
+        auto prev = static_cast<Unsigned>((i - 1) & mask);
+        if (successor(code_type(value)) != code_type(next) ||
+            predecessor(code_type(value)) != code_type(prev))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 int main()
 {
     using namespace cppgray;
@@ -207,6 +393,23 @@ int main()
         static_assert(max_gr == max_uint, "");
     }
 
+    // Convert to and from 64-bit unsigned integers
+    {
+        constexpr auto max_ull = std::numeric_limits<unsigned long long>::max();
+        static_assert(gray(max_ull) == max_ull, "");
+        static_assert(static_cast<unsigned long long>(gray(0x8000000000000001ull))
+                      == 0x8000000000000001ull, "");
+
+        // Runtime conversions may use a different algorithm
+        volatile unsigned long long values[] = {
+            0ull, 1ull, 0x8000000000000000ull, 0xdeadbeefcafebabeull, max_ull
+        };
+        for (unsigned long long value: values)
+        {
+            assert(static_cast<unsigned long long>(gray(value)) == value);
+        }
+    }
+
     ////////////////////////////////////////////////////////////
     // Construction
 
@@ -218,6 +421,18 @@ int main()
         static_assert(gr2.value == 0ull, "");
     }
 
+    // Construction from a bitset wider than 64 bits
+    {
+        std::bitset<128> bits(0x1234u);
+        bits.set(100);
+        gray_code<unsigned> gr(bits);
+        assert(gr.value == 0x1234u);
+
+        gray_code<std::uint16_t, 12> gr12;
+        gr12 = std::bitset<128>(0xf123u) | (std::bitset<128>(1u) << 127);
+        assert(gr12.value == 0x123u);
+    }
+
     ////////////////////////////////////////////////////////////
     // Comparison operators
 
@@ -232,6 +447,43 @@ int main()
         static_assert(gr != gray(89u), "");
     }
 
+    {
+        static_assert(ordering<unsigned char>(0u, 255u), "");
+        static_assert(ordering<unsigned>(0xfffffff0u, 0xffffffffu), "");
+        static_assert(gray(0x8000000000000000ull) > gray(0x7fffffffffffffffull), "");
+        static_assert(gray(1ull) < gray(0xffffffffffffffffull), "");
+        static_assert(not (gray(12u) < gray(12u)), "");
+
+#if defined(CPPGRAY_HAS_THREE_WAY_COMPARISON)
+        static_assert((gray(52u) <=> gray(52u)) == 0, "");
+        static_assert((gray(52u) <=> gray(53u)) < 0, "");
+        static_assert((gray(54u) <=> gray(53u)) > 0, "");
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Arithmetic operations
+
+    {
+        constexpr auto gr1 = gray(42u);
+        constexpr auto gr2 = gray(28u);
+
+        static_assert(gr1 + gr2 == 70u, "");
+        static_assert(gr1 - gr2 == 14u, "");
+        static_assert(gr2 - gr1 == std::numeric_limits<unsigned>::max() - 13u, "");
+        static_assert(gr1 + 5u == 47u, "");
+        static_assert(5u + gr1 == 47u, "");
+        static_assert(gr1 - 5u == 37u, "");
+
+        // Wrap around like the underlying type
+        constexpr auto max_uc = std::numeric_limits<unsigned char>::max();
+        static_assert(gray<unsigned char>(max_uc) + gray<unsigned char>(3) == static_cast<unsigned char>(2), "");
+
+        static_assert(distance(gr2, gr1) == 14, "");
+        static_assert(distance(gr1, gr2) == -14, "");
+        static_assert(distance(gray(0ull), gray(1ull << 40)) == (1ll << 40), "");
+    }
+
     ////////////////////////////////////////////////////////////
     // Bitwise operations
 
@@ -274,6 +526,53 @@ int main()
         static_assert(not is_odd(gray(8u)), "");
         static_assert(not is_odd(gray(0u)), "");
         static_assert(is_odd(gray(5u)), "");
+
+        // The upper bits of wide types are taken into account
+        static_assert(is_odd(gray(0xffffffffffffffffull)), "");
+        static_assert(is_even(gray(0xffffffff00000000ull)), "");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Neighbourhood functions
+
+    // hamming_distance
+    {
+        static_assert(hamming_distance(gray(0u), gray(0u)) == 0, "");
+        static_assert(hamming_distance(gray(4u), gray(5u)) == 1, "");
+        static_assert(hamming_distance(gray(0u), gray(0xffffffffu)) == 1, "");
+        static_assert(hamming_distance(gray_code<std::uint8_t>(), ~gray_code<std::uint8_t>()) == 8, "");
+        static_assert(hamming_distance(~gray(0ull), gray(0ull)) == 64, "");
+    }
+
+    // is_adjacent
+    {
+        static_assert(is_adjacent(gray(4u), gray(5u)), "");
+        static_assert(is_adjacent(gray(5u), gray(4u)), "");
+        static_assert(not is_adjacent(gray(4u), gray(4u)), "");
+        static_assert(not is_adjacent(gray(4u), gray(6u)), "");
+
+        // A single bit differs, but 1 and 6 are not consecutive
+        static_assert(hamming_distance(gray(1u), gray(6u)) == 1, "");
+        static_assert(not is_adjacent(gray(1u), gray(6u)), "");
+
+        // The sequence wraps around
+        static_assert(is_adjacent(gray(0xffffffffu), gray(0u)), "");
+        static_assert(is_adjacent(gray_code<std::uint16_t, 12>(std::uint16_t(4095)),
+                                  gray_code<std::uint16_t, 12>(std::uint16_t(0))), "");
+        static_assert(is_adjacent(gray_code<std::uint8_t, 1>(false), gray_code<std::uint8_t, 1>(true)), "");
+
+        // Exhaustive check on small Gray codes
+        for (unsigned i = 0 ; i < 64 ; ++i)
+        {
+            for (unsigned j = 0 ; j < 64 ; ++j)
+            {
+                auto lhs = gray_code<std::uint8_t, 6>(static_cast<std::uint8_t>(i));
+                auto rhs = gray_code<std::uint8_t, 6>(static_cast<std::uint8_t>(j));
+                bool consecutive = (i + 1) % 64 == j || (j + 1) % 64 == i;
+                assert(is_adjacent(lhs, rhs) == consecutive);
+                assert(hamming_distance(lhs, rhs) == std::bitset<8>(lhs.value ^ rhs.value).count());
+            }
+        }
     }
 
     ////////////////////////////////////////////////////////////
@@ -305,6 +604,21 @@ int main()
         static_assert(res >> 13 & 1, "");
     }
 
+    ////////////////////////////////////////////////////////////
+    // Test arithmetic assignment and advance functions
+
+    {
+        constexpr auto res = arithmetic();
+
+        // Arithmetic assignment operators
+        static_assert(res >> 0 & 1, "");
+        static_assert(res >> 1 & 1, "");
+
+        // advance function
+        static_assert(res >> 2 & 1, "");
+        static_assert(res >> 3 & 1, "");
+    }
+
     ////////////////////////////////////////////////////////////
     // Test increment functions
 
@@ -321,4 +635,96 @@ int main()
         static_assert(res >> 4 & 1, "");
         static_assert(res >> 5 & 1, "");
     }
+    ////////////////////////////////////////////////////////////
+    // Test successor and predecessor functions
+
+    {
+        static_assert(steps<std::uint8_t, 8>(), "");
+        static_assert(steps<std::uint8_t, 1>(), "");
+        static_assert(steps<std::uint16_t, 11>(), "");
+        static_assert(steps<std::uint32_t, 12>(), "");
+        static_assert(steps<std::uint64_t, 9>(), "");
+
+        constexpr auto max_ull = std::numeric_limits<unsigned long long>::max();
+        static_assert(successor(gray(max_ull)).value == 0u, "");
+        static_assert(predecessor(gray(0ull)) == gray(max_ull), "");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Test Gray codes narrower than their underlying type
+
+    {
+        constexpr auto res = sub_word();
+
+        // Construction
+        static_assert(res >> 0 & 1, "");
+        static_assert(res >> 1 & 1, "");
+
+        // Incrementation and decrementation
+        static_assert(res >> 2 & 1, "");
+        static_assert(res >> 3 & 1, "");
+        static_assert(res >> 4 & 1, "");
+
+        // Bitwise operations
+        static_assert(res >> 5 & 1, "");
+        static_assert(res >> 6 & 1, "");
+
+        // Arithmetic
+        static_assert(res >> 7 & 1, "");
+        static_assert(res >> 8 & 1, "");
+        static_assert(res >> 9 & 1, "");
+
+        static_assert(gray_code<std::uint16_t, 12>::bits == 12, "");
+        static_assert(gray_code<std::uint16_t, 12>::mask == 0xfffu, "");
+        static_assert(gray_code<std::uint8_t, 3>(std::uint8_t(13u)) == std::uint8_t(5u), "");
+    }
+#if defined(CPPGRAY_HAS_INT128)
+    ////////////////////////////////////////////////////////////
+    // Test 128-bit Gray codes
+
+    {
+        constexpr auto res = wide();
+
+        // Conversions
+        static_assert(res >> 0 & 1, "");
+        static_assert(res >> 1 & 1, "");
+
+        // Incrementation and decrementation
+        static_assert(res >> 2 & 1, "");
+        static_assert(res >> 3 & 1, "");
+
+        // Parity, ordering and distance
+        static_assert(res >> 4 & 1, "");
+        static_assert(res >> 5 & 1, "");
+        static_assert(res >> 6 & 1, "");
+        static_assert(res >> 7 & 1, "");
+        static_assert(res >> 8 & 1, "");
+
+        // Runtime conversions may use a different algorithm
+        using u128 = detail::uint128_type;
+        volatile unsigned long long halves[] = {
+            0ull, 1ull, 0x8000000000000000ull, 0xdeadbeefcafebabeull, ~0ull
+        };
+        for (unsigned long long upper: halves)
+        {
+            for (unsigned long long lower: halves)
+            {
+                u128 value = (u128(upper) << 64) | lower;
+                assert(static_cast<u128>(gray(value)) == value);
+
+                // Sub-word code using both halves
+                u128 masked = value & (~u128(0) >> 28);
+                assert((static_cast<u128>(gray_code<u128, 100>(value)) == masked));
+            }
+        }
+
+        // Bitset conversions keep both halves
+        auto gr = gray((u128(0x1234u) << 64) | 0x5678u);
+        std::bitset<128> bits = static_cast<std::bitset<128>>(gr);
+        assert(gray_code<u128>(bits) == gr);
+        assert((bits >> 64).to_ullong() == static_cast<unsigned long long>(gr.value >> 64));
+        assert((bits & std::bitset<128>(~0ull)).to_ullong() == static_cast<unsigned long long>(gr.value));
+        assert(is_odd(gr) == (bits.count() % 2 == 1));
+    }
+#endif
 }
@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cpp-gray/hamming.h>
+
+template<typename Unsigned, std::size_t Bits = std::numeric_limits<Unsigned>::digits>
+auto test_queries(std::size_t size, std::size_t chunks)
+    -> void
+{
+    using namespace cppgray;
+    using code_type = gray_code<Unsigned, Bits>;
+
+    // Clusters of codes around a few centres, so that small
+    // radiuses match some of the codes
+    std::mt19937_64 engine(size * 31 + chunks);
+    std::vector<code_type> centres(8);
+    for (auto& centre: centres)
+    {
+        centre = code_type(static_cast<Unsigned>(engine()));
+    }
+    std::vector<code_type> codes(size);
+    for (auto& code: codes)
+    {
+        code = centres[engine() % centres.size()];
+        for (int flips = engine() % 6 ; flips ; --flips)
+        {
+            code.value ^= static_cast<Unsigned>(Unsigned(1) << (engine() % Bits));
+        }
+    }
+
+    hamming_index<Unsigned, Bits> index(codes.data(), codes.size(), chunks);
+    assert(index.size() == size);
+    assert(chunks == 0 || index.chunks() == (chunks < Bits ? chunks : Bits));
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        assert(index[i] == codes[i]);
+    }
+
+    for (int q = 0 ; q < 20 ; ++q)
+    {
+        auto query = q % 2 ? centres[q % centres.size()]
+                           : code_type(static_cast<Unsigned>(engine()));
+        for (std::size_t radius: { 0u, 1u, 2u, 3u, 5u, 8u })
+        {
+            std::vector<std::size_t> expected;
+            for (std::size_t i = 0 ; i < size ; ++i)
+            {
+                if (hamming_distance(query, codes[i]) <= radius)
+                {
+                    expected.push_back(i);
+                }
+            }
+            assert(index.find_within(query, radius) == expected);
+        }
+    }
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    // Automatic number of chunks
+    test_queries<std::uint32_t>(0, 0);
+    test_queries<std::uint32_t>(1, 0);
+    test_queries<std::uint32_t>(1000, 0);
+    test_queries<std::uint64_t>(5000, 0);
+    test_queries<std::uint16_t>(3000, 0);
+    test_queries<std::uint16_t, 12>(500, 0);
+
+    // Explicit number of chunks, including uneven ones
+    test_queries<std::uint16_t>(1000, 1);
+    test_queries<std::uint32_t>(1000, 3);
+    test_queries<std::uint64_t>(2000, 5);
+    test_queries<std::uint8_t>(300, 8);
+    test_queries<std::uint8_t>(300, 20);
+
+    ////////////////////////////////////////////////////////////
+    // Every code is found once with large radiuses
+
+    {
+        std::vector<gray_code<std::uint16_t>> codes;
+        for (unsigned i = 0 ; i < 256 ; ++i)
+        {
+            codes.push_back(gray(static_cast<std::uint16_t>(i * 257u)));
+        }
+        hamming_index<std::uint16_t> index(codes.data(), codes.size(), 4);
+        std::size_t count = 0;
+        index.for_each_within(gray(std::uint16_t(0)), 16, [&](std::size_t) { ++count; });
+        assert(count == codes.size());
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Radiuses reaching the width of the codes
+
+    {
+        auto code = gray(std::uint64_t(5u));
+        hamming_index<std::uint64_t> index(&code, 1);
+        assert(index.find_within(code, 64) == std::vector<std::size_t>{ 0 });
+        assert(index.find_within(code, 100) == std::vector<std::size_t>{ 0 });
+
+        std::vector<gray_code<std::uint64_t>> codes;
+        for (std::uint64_t i = 0 ; i < 100 ; ++i)
+        {
+            codes.push_back(gray(i * 0x9e3779b97f4a7c15u));
+        }
+        hamming_index<std::uint64_t> whole(codes.data(), codes.size(), 1);
+        assert(whole.find_within(codes[7], 64).size() == codes.size());
+        assert(whole.find_within(codes[7], 65).size() == codes.size());
+    }
+}
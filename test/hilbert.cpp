@@ -0,0 +1,268 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <cpp-gray/hilbert.h>
+
+constexpr auto morton()
+    -> bool
+{
+    using namespace cppgray;
+    using u32 = std::uint32_t;
+    using u64 = std::uint64_t;
+
+    bool res = morton_encode<u32>(1u, 0u) == 1u;
+    res = res && morton_encode<u32>(0u, 1u) == 2u;
+    res = res && morton_encode<u32>(1u, 2u) == 9u;
+    res = res && morton_encode<u32>(0xffffu, 0xffffu) == 0xffffffffu;
+    res = res && morton_encode<u64>(0xffffffffu, 0u) == 0x5555555555555555u;
+    res = res && morton_encode<u32>(1u, 1u, 1u) == 7u;
+    res = res && morton_encode<u32>(2u, 0u, 1u) == 12u;
+    res = res && morton_encode<u64>(0u, 0u, 0x1fffffu) == 0x4924924924924924u;
+
+    // Upper bits of the coordinates are ignored
+    res = res && morton_encode<u32>(0x10001u, 0u) == 1u;
+    res = res && morton_encode<u32>(0x400u, 0u, 0u) == 0u;
+
+    const auto pos = morton_decode<2>(u32(9u));
+    res = res && pos[0] == 1u && pos[1] == 2u;
+    const auto pos3 = morton_decode<3>(u64(0x4924924924924924u));
+    res = res && pos3[0] == 0u && pos3[1] == 0u && pos3[2] == 0x1fffffu;
+
+    return res;
+}
+
+constexpr auto hilbert()
+    -> bool
+{
+    using namespace cppgray;
+    using u32 = std::uint32_t;
+
+    bool res = hilbert_encode<u32>(0u, 0u) == 0u;
+    for (u32 key = 0 ; key < 64 ; ++key)
+    {
+        const auto pos = hilbert_decode<2>(key);
+        res = res && hilbert_encode<u32>(pos[0], pos[1]) == key;
+        const auto pos3 = hilbert_decode<3>(key);
+        res = res && hilbert_encode<u32>(pos3[0], pos3[1], pos3[2]) == key;
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////
+// Reference Morton interleaving, one bit at a time
+
+template<typename Key, std::size_t Dims>
+auto naive_morton(const std::array<std::uint32_t, Dims>& coords)
+    -> Key
+{
+    constexpr std::size_t bits = std::numeric_limits<Key>::digits / Dims;
+    Key res = 0;
+    for (std::size_t bit = 0 ; bit < bits ; ++bit)
+    {
+        for (std::size_t i = 0 ; i < Dims ; ++i)
+        {
+            res |= static_cast<Key>(static_cast<Key>(coords[i] >> bit & 1u) << (bit * Dims + i));
+        }
+    }
+    return res;
+}
+
+template<std::size_t Dims>
+auto distance(const std::array<std::uint32_t, Dims>& lhs,
+              const std::array<std::uint32_t, Dims>& rhs)
+    -> std::uint64_t
+{
+    std::uint64_t res = 0;
+    for (std::size_t i = 0 ; i < Dims ; ++i)
+    {
+        res += lhs[i] > rhs[i] ? lhs[i] - rhs[i] : rhs[i] - lhs[i];
+    }
+    return res;
+}
+
+template<typename Key, std::size_t Dims>
+auto decode(Key key)
+    -> std::array<std::uint32_t, Dims>
+{
+    return cppgray::hilbert_decode<Dims>(key);
+}
+
+template<typename Key>
+auto encode(const std::array<std::uint32_t, 2>& pos)
+    -> Key
+{
+    return cppgray::hilbert_encode<Key>(pos[0], pos[1]);
+}
+
+template<typename Key>
+auto encode(const std::array<std::uint32_t, 3>& pos)
+    -> Key
+{
+    return cppgray::hilbert_encode<Key>(pos[0], pos[1], pos[2]);
+}
+
+// Consecutive keys are neighbouring cells, and going
+// back to the key gives the original key
+template<typename Key, std::size_t Dims>
+auto walk(Key first, std::size_t size)
+    -> void
+{
+    auto prev = decode<Key, Dims>(first);
+    assert(encode<Key>(prev) == first);
+    for (std::size_t i = 1 ; i < size ; ++i)
+    {
+        Key key = static_cast<Key>(first + i);
+        auto pos = decode<Key, Dims>(key);
+        assert(distance(prev, pos) == 1u);
+        assert(encode<Key>(pos) == key);
+        prev = pos;
+    }
+}
+
+int main()
+{
+    using namespace cppgray;
+    using u32 = std::uint32_t;
+    using u64 = std::uint64_t;
+
+    static_assert(morton(), "");
+    static_assert(hilbert(), "");
+
+    ////////////////////////////////////////////////////////////
+    // Morton keys against the reference
+
+    {
+        std::srand(42);
+        for (int i = 0 ; i < 10000 ; ++i)
+        {
+            auto x = static_cast<u32>(std::rand()) * 2654435761u;
+            auto y = static_cast<u32>(std::rand()) ^ static_cast<u32>(std::rand()) << 16;
+            auto z = static_cast<u32>(std::rand()) * 40503u;
+
+            assert(morton_encode<u32>(x, y) == (naive_morton<u32, 2>({{ x, y }})));
+            assert(morton_encode<u64>(x, y) == (naive_morton<u64, 2>({{ x, y }})));
+            assert(morton_encode<u32>(x, y, z) == (naive_morton<u32, 3>({{ x, y, z }})));
+            assert(morton_encode<u64>(x, y, z) == (naive_morton<u64, 3>({{ x, y, z }})));
+
+            auto pos = morton_decode<2>(morton_encode<u64>(x, y));
+            assert(pos[0] == x && pos[1] == y);
+            auto pos3 = morton_decode<3>(morton_encode<u64>(x, y, z));
+            assert(pos3[0] == (x & 0x1fffffu) && pos3[1] == (y & 0x1fffffu) && pos3[2] == (z & 0x1fffffu));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Hilbert curve properties
+
+    walk<u32, 2>(0u, 1u << 16);
+    walk<u64, 2>(0u, 1u << 16);
+    walk<u32, 3>(0u, 1u << 15);
+    walk<u64, 3>(0u, 1u << 15);
+    walk<u32, 2>(0xffffffffu - 4096u, 4096u);
+    walk<u64, 2>(0xffffffffffffffffu - 4096u, 4096u);
+    walk<u32, 3>(0x3fffffffu - 4096u, 4096u);
+    walk<u64, 3>(0x7fffffffffffffffu - 4096u, 4096u);
+    walk<u64, 2>(0x0123456789abcdefu, 4096u);
+    walk<u64, 3>(0x0123456789abcdefu, 4096u);
+
+    {
+        // The first 4^8 cells fill a 256x256 square
+        std::vector<bool> seen(256 * 256, false);
+        for (u32 key = 0 ; key < 256u * 256u ; ++key)
+        {
+            auto pos = hilbert_decode<2>(key);
+            assert(pos[0] < 256u && pos[1] < 256u);
+            assert(not seen[pos[0] * 256 + pos[1]]);
+            seen[pos[0] * 256 + pos[1]] = true;
+        }
+    }
+
+    {
+        // The first 8^5 cells fill a 32x32x32 cube
+        std::vector<bool> seen(32 * 32 * 32, false);
+        for (u64 key = 0 ; key < 32u * 32u * 32u ; ++key)
+        {
+            auto pos = hilbert_decode<3>(key);
+            assert(pos[0] < 32u && pos[1] < 32u && pos[2] < 32u);
+            auto idx = (pos[0] * 32 + pos[1]) * 32 + pos[2];
+            assert(not seen[idx]);
+            seen[idx] = true;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Batch operations
+
+    {
+        constexpr std::size_t size = 1000;
+        std::vector<u32> x(size), y(size), z(size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            x[i] = static_cast<u32>(i * 7919u);
+            y[i] = static_cast<u32>(i * 104729u);
+            z[i] = static_cast<u32>(i * 31u);
+        }
+
+        std::vector<u64> keys(size);
+        std::vector<u32> x2(size), y2(size), z2(size);
+
+        morton_encode(x.data(), y.data(), keys.data(), size);
+        morton_decode(keys.data(), x2.data(), y2.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(keys[i] == morton_encode<u64>(x[i], y[i]));
+            assert(x2[i] == x[i] && y2[i] == y[i]);
+        }
+
+        hilbert_encode(x.data(), y.data(), keys.data(), size);
+        hilbert_decode(keys.data(), x2.data(), y2.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(keys[i] == hilbert_encode<u64>(x[i], y[i]));
+            assert(x2[i] == x[i] && y2[i] == y[i]);
+        }
+
+        std::vector<u32> keys32(size);
+        morton_encode(x.data(), y.data(), z.data(), keys32.data(), size);
+        morton_decode(keys32.data(), x2.data(), y2.data(), z2.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(keys32[i] == morton_encode<u32>(x[i], y[i], z[i]));
+            assert(x2[i] == (x[i] & 0x3ffu) && y2[i] == (y[i] & 0x3ffu) && z2[i] == (z[i] & 0x3ffu));
+        }
+
+        hilbert_encode(x.data(), y.data(), z.data(), keys32.data(), size);
+        hilbert_decode(keys32.data(), x2.data(), y2.data(), z2.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(keys32[i] == hilbert_encode<u32>(x[i], y[i], z[i]));
+            assert(x2[i] == (x[i] & 0x3ffu) && y2[i] == (y[i] & 0x3ffu) && z2[i] == (z[i] & 0x3ffu));
+        }
+    }
+}
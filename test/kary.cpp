@@ -0,0 +1,187 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <cpp-gray/gray.h>
+#include <cpp-gray/kary.h>
+
+constexpr auto kary()
+    -> bool
+{
+    using namespace cppgray;
+
+    // 5 is 0 1 1 in base 4, the last digit is reversed
+    constexpr kary_gray_code<4, 3> pam(5);
+    bool res = pam.digit(2) == 0u && pam.digit(1) == 1u && pam.digit(0) == 2u;
+    res = res && static_cast<std::uint8_t>(pam) == 5u;
+
+    // Base 3: 0 1 2 | 5 4 3 | 6 7 8
+    constexpr kary_gray_code<3, 2> code(4);
+    res = res && code.value == 4u;
+    res = res && kary_gray_code<3, 2>(5).value == 3u;
+    res = res && kary_gray_code<3, 2>(3).value == 5u;
+
+    // The value is taken modulo Base^Digits
+    res = res && kary_gray_code<3, 2>(9) == kary_gray_code<3, 2>(0);
+    res = res && kary_gray_code<4, 3>(64) == kary_gray_code<4, 3>(0);
+
+    res = res && kary_gray_code<10, 19>::max_value == 9999999999999999999u;
+    res = res && kary_gray_code<16, 16>::max_value == 0xffffffffffffffffu;
+    res = res && kary_gray_code<4, 3>::digit_bits == 2u;
+    res = res && kary_gray_code<10, 3>::digit_bits == 0u;
+
+    return res;
+}
+
+// Consecutive integers have codes that differ by one in one digit,
+// and the conversion goes both ways
+template<unsigned Base, std::size_t Digits>
+auto check_sequence(std::uint64_t first, std::uint64_t count)
+    -> void
+{
+    using namespace cppgray;
+    using code_type = kary_gray_code<Base, Digits>;
+    using value_type = typename code_type::value_type;
+
+    auto prev = code_type(static_cast<value_type>(first));
+    for (std::uint64_t i = 1 ; i < count ; ++i)
+    {
+        auto value = static_cast<value_type>(first + i);
+        code_type code(value);
+        assert(static_cast<value_type>(code) == value);
+
+        std::size_t changes = 0;
+        for (std::size_t pos = 0 ; pos < Digits ; ++pos)
+        {
+            auto lhs = prev.digit(pos);
+            auto rhs = code.digit(pos);
+            assert(lhs < Base && rhs < Base);
+            if (lhs != rhs)
+            {
+                ++changes;
+                assert(lhs + 1 == rhs || rhs + 1 == lhs);
+            }
+        }
+        assert(changes == 1u);
+        prev = code;
+    }
+}
+
+// The shift and mask path matches the digit walk
+template<unsigned Base, std::size_t Digits>
+auto check_power_of_two(std::uint64_t count)
+    -> void
+{
+    using namespace cppgray;
+    using code_type = kary_gray_code<Base, Digits>;
+
+    std::uint64_t state = 0x9e3779b97f4a7c15u;
+    for (std::uint64_t i = 0 ; i < count ; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        std::uint64_t value = state & code_type::max_value;
+
+        auto code = detail::kary_encode<Base, Digits>(value);
+        assert(code == (detail::kary_convert_digits<Base, Digits>(value, true)));
+        assert((detail::kary_decode<Base, Digits>(code) == value));
+        assert((detail::kary_convert_digits<Base, Digits>(code, false)) == value);
+    }
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    static_assert(kary(), "");
+
+    // Base 2 is the usual binary reflected Gray code
+    for (unsigned i = 0 ; i < 256 ; ++i)
+    {
+        auto value = static_cast<std::uint8_t>(i);
+        assert((kary_gray_code<2, 8>(value).value == gray(value).value));
+    }
+
+    check_sequence<2, 10>(0, 1024);
+    check_sequence<3, 5>(0, 243);
+    check_sequence<4, 5>(0, 1024);
+    check_sequence<5, 4>(0, 625);
+    check_sequence<8, 4>(0, 4096);
+    check_sequence<10, 4>(0, 10000);
+    check_sequence<16, 16>(0xffffffffffff0000u, 0x10000u);
+    check_sequence<10, 19>(9999999999999990000u, 10000u);
+    check_sequence<7, 22>(0, 5000);
+
+    check_power_of_two<2, 64>(10000);
+    check_power_of_two<4, 32>(10000);
+    check_power_of_two<8, 21>(10000);
+    check_power_of_two<16, 16>(10000);
+    check_power_of_two<4, 3>(1000);
+
+    ////////////////////////////////////////////////////////////
+    // Batch operations
+
+    {
+        using code_type = kary_gray_code<4, 16>;
+        constexpr std::size_t size = 1000;
+        std::vector<std::uint32_t> values(size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            values[i] = static_cast<std::uint32_t>(i * 2654435761u);
+        }
+
+        std::vector<code_type> codes(size);
+        encode(values.data(), codes.data(), size);
+        std::vector<std::uint32_t> decoded(size);
+        decode(codes.data(), decoded.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(codes[i] == code_type(values[i]));
+            assert(decoded[i] == values[i]);
+        }
+    }
+
+    {
+        using code_type = kary_gray_code<10, 9>;
+        constexpr std::size_t size = 1000;
+        std::vector<std::uint32_t> values(size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            values[i] = static_cast<std::uint32_t>(i * 999983u);
+        }
+
+        std::vector<code_type> codes(size);
+        encode(values.data(), codes.data(), size);
+        std::vector<std::uint32_t> decoded(size);
+        decode(codes.data(), decoded.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            assert(codes[i] == code_type(values[i]));
+            assert(decoded[i] == values[i] % 1000000000u);
+        }
+    }
+}
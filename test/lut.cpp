@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cpp-gray/lut.h>
+
+template<std::size_t Bits, typename Unsigned>
+auto test_tables()
+    -> void
+{
+    using namespace cppgray;
+
+    static constexpr auto decode_table = make_gray_decode_table<Bits>();
+    static constexpr auto encode_table = make_gray_encode_table<Bits>();
+    table_decoder<Bits> decoder;
+
+    for (std::size_t i = 0 ; i < decode_table.size() ; ++i)
+    {
+        auto value = static_cast<Unsigned>(i);
+        gray_code<Unsigned, Bits> code(value);
+
+        assert(encode_table[i] == code.value);
+        assert(decode_table[code.value] == value);
+        assert(decoder(code) == value);
+    }
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    ////////////////////////////////////////////////////////////
+    // Compile-time tables
+
+    static_assert(make_gray_decode_table<1>().size() == 2, "");
+    static_assert(make_gray_decode_table<8>().size() == 256, "");
+    constexpr auto decode_table = make_gray_decode_table<4>();
+    constexpr auto encode_table = make_gray_encode_table<4>();
+    static_assert(decode_table[0b1100] == 0b1000, "");
+    static_assert(encode_table[0b1000] == 0b1100, "");
+    static_assert(table_decoder<8>{}(gray(std::uint8_t(200))) == 200, "");
+    static_assert(std::is_same<gray_table_value_t<8>, std::uint8_t>::value, "");
+    static_assert(std::is_same<gray_table_value_t<9>, std::uint16_t>::value, "");
+
+    ////////////////////////////////////////////////////////////
+    // Tables against the regular conversions
+
+    test_tables<3, std::uint8_t>();
+    test_tables<8, std::uint8_t>();
+    test_tables<12, std::uint16_t>();
+    test_tables<12, std::uint32_t>();
+    test_tables<16, std::uint16_t>();
+}
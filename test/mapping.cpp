@@ -0,0 +1,139 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <cpp-gray/mapping.h>
+
+// Reference implementation building the Gray code bit by bit
+template<typename Mapping>
+auto naive_remap(typename Mapping::value_type raw, const std::vector<std::size_t>& lines)
+    -> typename Mapping::value_type
+{
+    using value_type = typename Mapping::value_type;
+    raw = static_cast<value_type>(raw ^ Mapping::inverted);
+    value_type res = 0;
+    for (std::size_t i = 0 ; i < lines.size() ; ++i)
+    {
+        res |= static_cast<value_type>(((raw >> lines[i]) & 1u) << i);
+    }
+    return res;
+}
+
+template<typename Mapping>
+auto check_mapping(std::vector<std::size_t> lines)
+    -> void
+{
+    using value_type = typename Mapping::value_type;
+
+    std::mt19937_64 engine(lines.size());
+    for (std::size_t size: { 0u, 1u, 7u, 33u, 1000u })
+    {
+        std::vector<value_type> raw(size);
+        for (auto& word: raw)
+        {
+            word = static_cast<value_type>(engine());
+        }
+
+        std::vector<value_type> positions(size);
+        std::vector<typename Mapping::code_type> codes(size);
+        Mapping::decode(raw.data(), positions.data(), size);
+        Mapping::remap(raw.data(), codes.data(), size);
+        for (std::size_t i = 0 ; i < size ; ++i)
+        {
+            auto code = naive_remap<Mapping>(raw[i], lines);
+            assert(Mapping::remap(raw[i]).value == code);
+            assert(codes[i].value == code);
+            assert(positions[i] == static_cast<value_type>(Mapping::remap(raw[i])));
+            assert(Mapping::decode(raw[i]) == positions[i]);
+
+            // The unused lines are 0 in the raw words
+            auto word = Mapping::encode(positions[i]);
+            assert(word == static_cast<value_type>(raw[i] & Mapping::lines_mask));
+            assert(Mapping::unmap(Mapping::remap(raw[i])) == word);
+        }
+    }
+}
+
+constexpr auto mapping()
+    -> bool
+{
+    using namespace cppgray;
+
+    // Reversed nibble, with an inverted line
+    using wiring = bit_mapping<std::uint8_t, 0x20, 7, 6, 5, 4>;
+    static_assert(wiring::bits == 4, "");
+    static_assert(wiring::lines_mask == 0xf0, "");
+
+    bool res = true;
+    for (unsigned i = 0 ; i < 16 ; ++i)
+    {
+        auto raw = wiring::encode(static_cast<std::uint8_t>(i));
+        res = res && wiring::decode(raw) == i;
+        res = res && wiring::decode(static_cast<std::uint8_t>(raw | 0x0f)) == i;
+    }
+    // Gray code 0b0001 is carried by line 7, line 5 is inverted
+    res = res && wiring::encode(1) == 0xa0;
+    res = res && wiring::remap(0xa0).value == 1;
+    return res;
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    static_assert(mapping(), "");
+
+    static_assert(detail::mapping_group_count<0, 1, 2, 3>() == 1, "");
+    static_assert(detail::mapping_group_count<3, 2, 1, 0>() == 4, "");
+    static_assert(detail::mapping_group_count<4, 5, 0, 1, 2, 3>() == 2, "");
+    static_assert(detail::mapping_group_at<4, 5, 0, 1, 2, 3>(0).shift == 4, "");
+    static_assert(detail::mapping_group_at<4, 5, 0, 1, 2, 3>(0).mask == 0x30, "");
+    static_assert(detail::mapping_group_at<4, 5, 0, 1, 2, 3>(1).shift == -2, "");
+    static_assert(detail::mapping_group_at<4, 5, 0, 1, 2, 3>(1).mask == 0x0f, "");
+
+    // Identity
+    check_mapping<bit_mapping<std::uint16_t, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11>>(
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }
+    );
+    // Lines in order with gaps, a single pext with BMI2
+    check_mapping<bit_mapping<std::uint32_t, 0x00ff00ff, 1, 3, 5, 8, 13, 21, 30>>(
+        { 1, 3, 5, 8, 13, 21, 30 }
+    );
+    // Swapped bytes
+    check_mapping<bit_mapping<std::uint16_t, 0x8001, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7>>(
+        { 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7 }
+    );
+    // Reversed bits
+    check_mapping<bit_mapping<std::uint8_t, 0xff, 7, 6, 5, 4, 3, 2, 1, 0>>(
+        { 7, 6, 5, 4, 3, 2, 1, 0 }
+    );
+    // Scrambled 64-bit wiring
+    check_mapping<bit_mapping<std::uint64_t, 0xf0f0000000000001u,
+                              63, 0, 17, 18, 19, 40, 41, 2, 5, 33, 34, 35, 36, 60>>(
+        { 63, 0, 17, 18, 19, 40, 41, 2, 5, 33, 34, 35, 36, 60 }
+    );
+}
@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <cpp-gray/packed_vector.h>
+
+template<std::size_t Bits>
+auto test_packed()
+    -> void
+{
+    using namespace cppgray;
+    using vector_type = packed_gray_vector<Bits>;
+    using integer_type = typename vector_type::integer_type;
+    using value_type = typename vector_type::value_type;
+
+    // Deterministic pseudo-random values
+    constexpr std::size_t size = 3001;
+    std::vector<integer_type> values(size);
+    std::uint64_t state = 0x9e3779b97f4a7c15u;
+    for (auto& value: values)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        value = static_cast<integer_type>(state & value_type::mask);
+    }
+
+    vector_type vec(size);
+    assert(vec.size() == size);
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        assert(vec[i] == value_type());
+        vec[i] = value_type(values[i]);
+    }
+
+    // Neighbours are not overwritten
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+        value_type code = vec[i];
+        assert(static_cast<integer_type>(code) == values[i]);
+    }
+
+    // Bulk operations on a range crossing several chunks
+    std::vector<value_type> codes(size - 3);
+    vec.unpack(3, size - 3, codes.data());
+    std::vector<integer_type> decoded(size - 3);
+    vec.decode(3, size - 3, decoded.data());
+    for (std::size_t i = 0 ; i < size - 3 ; ++i)
+    {
+        assert(codes[i] == value_type(values[i + 3]));
+        assert(decoded[i] == values[i + 3]);
+    }
+
+    // Proxy to proxy assignment
+    vec[0] = vec[1];
+    assert(vec[0] == vec[1]);
+    assert(vec[0] != vec[2] || values[1] == values[2]);
+
+    // Growing after shrinking gives Gray codes 0
+    vec.resize(10);
+    vec.resize(20);
+    for (std::size_t i = 10 ; i < 20 ; ++i)
+    {
+        assert(vec[i] == value_type());
+    }
+
+    vec.clear();
+    assert(vec.empty());
+    vec.push_back(value_type(values[5]));
+    vec.push_back(value_type(values[6]));
+    assert(vec.size() == 2);
+    assert(vec[1] == value_type(values[6]));
+}
+
+int main()
+{
+    test_packed<1>();
+    test_packed<3>();
+    test_packed<8>();
+    test_packed<12>();
+    test_packed<17>();
+    test_packed<33>();
+    test_packed<63>();
+    test_packed<64>();
+}
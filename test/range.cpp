@@ -0,0 +1,286 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#define CPPGRAY_USE_EXECUTION_POLICIES
+#include <cpp-gray/range.h>
+
+// Function object accumulating the flipped bits, usable
+// in constant expressions unlike C++14 lambdas
+struct flip_recorder
+{
+    std::uint64_t code = 0u;
+    std::uint64_t flips = 0u;
+    std::size_t count = 0u;
+
+    constexpr auto operator()(int bit)
+        -> void
+    {
+        code ^= std::uint64_t(1) << bit;
+        flips = flips * 8u + static_cast<std::uint64_t>(bit);
+        ++count;
+    }
+};
+
+constexpr auto iterate(std::size_t bits)
+    -> bool
+{
+    using namespace cppgray;
+
+    // Every code is the one at its position, and every step
+    // flips exactly the reported bit
+    std::uint64_t position = 0u;
+    gray_code<unsigned> previous{};
+    for (auto it = gray_range<unsigned>(bits).begin()
+         ; it != gray_range<unsigned>(bits).end() ; ++it, ++position)
+    {
+        if (*it != gray(static_cast<unsigned>(position))) return false;
+        if (it.position() != position) return false;
+        if (position > 0 &&
+            (previous ^ *it).value != (1u << it.flipped_bit())) return false;
+        previous = *it;
+    }
+    return position == (std::uint64_t(1) << bits);
+}
+
+constexpr auto iterate_subrange()
+    -> bool
+{
+    using namespace cppgray;
+
+    auto range = gray_range<unsigned short>(5u, 12u);
+    std::uint64_t position = 5u;
+    for (auto code: range)
+    {
+        if (code != gray(static_cast<unsigned short>(position++))) return false;
+    }
+    return position == 12u && range.size() == 7u;
+}
+
+constexpr auto random_access()
+    -> bool
+{
+    using namespace cppgray;
+
+    auto range = gray_range<unsigned>(10u);
+    auto it = range.begin();
+
+    it += 300;
+    if (*it != gray(300u) || it.position() != 300u) return false;
+    it -= 45;
+    if (*it != gray(255u)) return false;
+    if (it[17] != gray(272u) || it[-55] != gray(200u)) return false;
+    if ((it + 1).flipped_bit() != 8) return false;
+
+    --it;
+    if (*it != gray(254u) || it.flipped_bit() != 1) return false;
+
+    if (range.end() - it != 1024 - 254) return false;
+    if (not (it < range.end()) || it >= range.end()) return false;
+    return range.begin() + 1024 == range.end();
+}
+
+template<typename Unsigned>
+constexpr auto full_width()
+    -> bool
+{
+    using namespace cppgray;
+
+    // The end of a full-width range is past the last code,
+    // which steps to and from 0 by flipping its highest bit
+    constexpr int digits = std::numeric_limits<Unsigned>::digits;
+    constexpr Unsigned max = std::numeric_limits<Unsigned>::max();
+    auto range = gray_range<Unsigned>(digits);
+
+    auto last = range.end();
+    --last;
+    if (*last != gray(max) || last.position() != max) return false;
+
+    auto it = range.end() - 3;
+    ++it;
+    ++it;
+    if (*it != gray(max) || it.flipped_bit() != 0) return false;
+    ++it;
+    if (it != range.end() || *it != gray(Unsigned(0u))) return false;
+    return it.flipped_bit() == digits - 1;
+}
+
+template<typename Unsigned>
+constexpr auto wrap_around(std::uint64_t first, std::uint64_t last)
+    -> bool
+{
+    using namespace cppgray;
+
+    // A range crossing a multiple of 1 << digits wraps around
+    // to the start of the sequence, and every reported flip
+    // stays within the bits of Unsigned
+    constexpr int digits = std::numeric_limits<Unsigned>::digits;
+    auto range = gray_range<Unsigned>(first, last);
+    auto previous = *range.begin();
+    for (auto it = range.begin() + 1 ; it != range.end() ; ++it)
+    {
+        int bit = it.flipped_bit();
+        if (bit >= digits) return false;
+        if (*it != gray(static_cast<Unsigned>(it.position()))) return false;
+        if ((previous ^ *it).value != static_cast<Unsigned>(Unsigned(1) << bit)) return false;
+        previous = *it;
+    }
+
+    // Replaying the flips from the first code reproduces the slice
+    struct replay
+    {
+        Unsigned code;
+        bool valid;
+
+        constexpr auto operator()(int bit)
+            -> void
+        {
+            valid = valid && bit < digits;
+            code ^= static_cast<Unsigned>(Unsigned(1) << (bit % digits));
+        }
+    };
+    auto res = for_each_gray_flip(range, replay{ (*range.begin()).value, true });
+    return res.valid && res.code == previous.value;
+}
+
+constexpr auto split()
+    -> bool
+{
+    using namespace cppgray;
+
+    // Split a range until its grain size, then check that
+    // the slices still cover it
+    gray_range<unsigned> range(3u, 103u, 30u);
+    bool res = range.is_divisible() && range.grain_size() == 30u;
+
+    gray_range<unsigned> upper(range, split_tag{});
+    res = res && range.begin().position() == 3u && range.end().position() == 53u;
+    res = res && upper.begin().position() == 53u && upper.end().position() == 103u;
+    res = res && range.is_divisible() && upper.grain_size() == 30u;
+
+    gray_range<unsigned> quarter(range, split_tag{});
+    res = res && range.size() == 25u && quarter.size() == 25u;
+    res = res && not range.is_divisible() && not quarter.is_divisible();
+    res = res && *quarter.begin() == gray(28u);
+    return res;
+}
+
+constexpr auto slice_flips()
+    -> bool
+{
+    using namespace cppgray;
+
+    // Replaying the flips of a slice from its first Gray
+    // code gives its last Gray code
+    gray_range<unsigned> slice(37u, 80u);
+    auto rec = for_each_gray_flip(slice, flip_recorder{ gray(37u).value });
+    bool res = rec.count == 42u && rec.code == gray(79u).value;
+
+    auto empty = for_each_gray_flip(gray_range<unsigned>(5u, 5u), flip_recorder{});
+    return res && empty.count == 0u;
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    ////////////////////////////////////////////////////////////
+    // gray_range
+
+    {
+        static_assert(iterate(0u), "");
+        static_assert(iterate(1u), "");
+        static_assert(iterate(5u), "");
+        static_assert(iterate_subrange(), "");
+        static_assert(random_access(), "");
+        static_assert(full_width<std::uint8_t>(), "");
+        static_assert(full_width<std::uint16_t>(), "");
+        static_assert(full_width<std::uint32_t>(), "");
+        static_assert(wrap_around<std::uint8_t>(250u, 300u), "");
+        static_assert(wrap_around<std::uint16_t>(65000u, 66000u), "");
+        static_assert(wrap_around<std::uint32_t>(0xfffffff0u, 0x100000010u), "");
+        static_assert(gray_range<std::uint8_t>(250u, 300u).begin().flipped_bit() == 1, "");
+        static_assert((gray_range<std::uint8_t>(250u, 300u).begin() + 6).flipped_bit() == 7, "");
+
+        static_assert(gray_range<unsigned>(4u).size() == 16u, "");
+        static_assert(not gray_range<unsigned>(0u).empty(), "");
+        static_assert(gray_range<unsigned>(3u, 3u).empty(), "");
+        static_assert(gray_range<unsigned>(4u).begin().flipped_bit() == 64, "");
+    }
+
+    {
+        // The codes are returned by value, so adaptors such as
+        // std::reverse_iterator don't refer to a dead iterator
+        auto range = gray_range<std::uint32_t>(32u);
+        std::reverse_iterator<gray_iterator<std::uint32_t>> it(range.end());
+        assert(*it == gray(std::uint32_t(0xffffffffu)));
+        ++it;
+        assert(*it == gray(std::uint32_t(0xfffffffeu)));
+        assert(it.base().position() == 0xffffffffu);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // for_each_gray_flip
+
+    {
+        // Ruler sequence 0 1 0 2 0 1 0, one octal digit per flip
+        constexpr auto rec = for_each_gray_flip(3u, flip_recorder{});
+        static_assert(rec.count == 7u, "");
+        static_assert(rec.flips == 0'1'0'2'0'1'0, "");
+        static_assert(rec.code == gray(7u).value, "");
+
+        constexpr auto empty = for_each_gray_flip(0u, flip_recorder{});
+        static_assert(empty.count == 0u, "");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Splitting and slices
+
+    {
+        static_assert(split(), "");
+        static_assert(slice_flips(), "");
+    }
+
+#if defined(__cpp_lib_execution)
+    {
+        // The slices cover the range exactly once
+        gray_range<unsigned> range(5u, 100005u, 1000u);
+        std::atomic<std::uint64_t> count(0u);
+        for_each_slice(std::execution::par, range, [&](gray_range<unsigned> slice) {
+            assert(slice.size() >= 1000u || slice.end() == range.end());
+            auto code = *slice.begin();
+            for_each_gray_flip(slice, [&](int bit) {
+                code.value ^= 1u << bit;
+            });
+            assert(code == *(slice.end() - 1));
+            count += slice.size();
+        });
+        assert(count == range.size());
+    }
+#endif
+}
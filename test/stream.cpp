@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <cpp-gray/range.h>
+#include <cpp-gray/stream.h>
+
+constexpr auto stream()
+    -> bool
+{
+    using namespace cppgray;
+    using u16 = std::uint16_t;
+
+    gray_stream_decoder<u16> dec;
+    bool res = dec.value() == 0u && dec.glitches() == 0u;
+
+    // Single bit changes
+    res = res && dec.update(gray(u16(1))) == 1u;
+    res = res && dec.update(gray(u16(2))) == 2u;
+    res = res && dec.update(gray(u16(1))) == 1u;
+    res = res && dec.glitches() == 0u;
+
+    // Repeated sample
+    res = res && dec.update(gray(u16(1))) == 1u;
+    res = res && dec.glitches() == 0u;
+
+    // Missed positions
+    res = res && dec.update(gray(u16(5))) == 5u;
+    res = res && dec.glitches() == 1u;
+    res = res && dec.code() == gray(u16(5));
+
+    // Reset
+    dec.reset(gray(u16(42)));
+    res = res && dec.value() == 42u && dec.glitches() == 0u;
+
+    return res;
+}
+
+template<typename Unsigned>
+auto follow_sequence()
+    -> void
+{
+    using namespace cppgray;
+
+    // Walk forward then backward through the sequence,
+    // wrapping around in both directions
+    constexpr auto max = std::numeric_limits<Unsigned>::max();
+    gray_stream_decoder<Unsigned> dec(gray(static_cast<Unsigned>(max - 100u)));
+    auto code = dec.code();
+    for (int i = 0 ; i < 300 ; ++i)
+    {
+        ++code;
+        assert(dec.update(code) == static_cast<Unsigned>(code));
+    }
+    for (int i = 0 ; i < 600 ; ++i)
+    {
+        --code;
+        assert(dec.update(code) == static_cast<Unsigned>(code));
+    }
+    assert(dec.glitches() == 0u);
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    static_assert(stream(), "");
+
+    follow_sequence<std::uint8_t>();
+    follow_sequence<std::uint16_t>();
+    follow_sequence<std::uint32_t>();
+    follow_sequence<std::uint64_t>();
+
+    ////////////////////////////////////////////////////////////
+    // Sub-word Gray codes
+
+    {
+        gray_stream_decoder<std::uint16_t, 12> dec;
+        gray_code<std::uint16_t, 12> code;
+        --code;
+        assert(dec.update(code) == 4095u);
+        assert(dec.glitches() == 0u);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Decoding the samples of a range
+
+    {
+        gray_stream_decoder<std::uint32_t> dec;
+        for (auto code: gray_range<std::uint32_t>(10))
+        {
+            assert(dec.update(code) == static_cast<std::uint32_t>(code));
+        }
+        assert(dec.value() == 1023u);
+        assert(dec.glitches() == 0u);
+    }
+}
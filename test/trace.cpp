@@ -0,0 +1,172 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cpp-gray/trace.h>
+
+template<typename Unsigned, std::size_t Bits>
+auto make_samples(std::size_t count)
+    -> std::vector<cppgray::gray_code<Unsigned, Bits>>
+{
+    using namespace cppgray;
+
+    // Mostly single steps in both directions, with some
+    // repeated samples and some jumps
+    std::mt19937_64 engine(Bits);
+    std::uniform_int_distribution<int> dist(0, 99);
+    std::vector<gray_code<Unsigned, Bits>> res;
+    gray_code<Unsigned, Bits> code;
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        auto event = dist(engine);
+        if (event < 60)
+        {
+            ++code;
+        }
+        else if (event < 85)
+        {
+            --code;
+        }
+        else if (event > 97)
+        {
+            code = gray_code<Unsigned, Bits>(static_cast<Unsigned>(engine()));
+        }
+        res.push_back(code);
+    }
+    return res;
+}
+
+template<typename Unsigned, std::size_t Bits = std::numeric_limits<Unsigned>::digits>
+auto roundtrip(std::size_t count, std::size_t interval)
+    -> void
+{
+    using namespace cppgray;
+
+    auto samples = make_samples<Unsigned, Bits>(count);
+    gray_trace_writer<Unsigned, Bits> writer(interval);
+    writer.push(samples.data(), samples.size());
+    assert(writer.size() == count);
+    assert(writer.keyframes().size() == (count + interval - 1) / interval);
+    assert(writer.words().size() == (writer.bit_size() + 63) / 64);
+
+    // Sequential reading
+    gray_trace_reader<Unsigned, Bits> reader(writer);
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        assert(reader.next() == samples[i]);
+        assert(reader.value() == static_cast<Unsigned>(samples[i]));
+    }
+    assert(reader.position() == count);
+
+    // Batch reading, from the start and past the end
+    std::vector<Unsigned> positions(count + 10);
+    reader.seek(0);
+    assert(reader.read(positions.data(), positions.size()) == count);
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        assert(positions[i] == static_cast<Unsigned>(samples[i]));
+    }
+
+    // Seeking around keyframes
+    for (std::size_t index: { std::size_t(0), std::size_t(1), interval - 1, interval,
+                              interval + 1, count / 2, count - 1, count })
+    {
+        if (index > count)
+        {
+            continue;
+        }
+        reader.seek(index);
+        assert(reader.position() == index);
+        if (index > 0)
+        {
+            assert(reader.code() == samples[index - 1]);
+        }
+        if (index < count)
+        {
+            assert(reader.next() == samples[index]);
+        }
+    }
+
+    // Reader over the stored parts of the trace
+    std::vector<std::uint64_t> words = writer.words();
+    std::vector<std::uint64_t> keyframes = writer.keyframes();
+    gray_trace_reader<Unsigned, Bits> stored(words.data(), count, keyframes.data(), interval);
+    stored.seek(count / 3);
+    assert(stored.read(positions.data(), 100) == 100);
+    for (std::size_t i = 0 ; i < 100 ; ++i)
+    {
+        assert(positions[i] == static_cast<Unsigned>(samples[count / 3 + i]));
+    }
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    static_assert(gray_trace_writer<std::uint32_t>::token_bits == 6, "");
+    static_assert(gray_trace_writer<std::uint16_t>::token_bits == 5, "");
+    static_assert(gray_trace_writer<std::uint64_t>::token_bits == 7, "");
+    static_assert(gray_trace_writer<std::uint16_t, 14>::token_bits == 4, "");
+    static_assert(gray_trace_writer<std::uint8_t, 1>::token_bits == 2, "");
+
+    roundtrip<std::uint8_t>(5000, 64);
+    roundtrip<std::uint16_t, 12>(5000, 100);
+    roundtrip<std::uint32_t>(20000, 4096);
+    roundtrip<std::uint32_t>(20000, 1);
+    roundtrip<std::uint64_t>(20000, 333);
+    roundtrip<std::uint8_t, 1>(1000, 7);
+
+    ////////////////////////////////////////////////////////////
+    // Size of a trace of single steps
+
+    {
+        gray_trace_writer<std::uint32_t> writer(1024);
+        gray_code<std::uint32_t> code;
+        for (int i = 0 ; i < 4096 ; ++i)
+        {
+            writer.push(code++);
+        }
+        // 4 keyframes of 6 + 32 bits, 4092 flips of 6 bits
+        assert(writer.bit_size() == 4 * 38 + 4092 * 6);
+
+        writer.clear();
+        assert(writer.size() == 0 && writer.bit_size() == 0);
+        assert(writer.words().empty() && writer.keyframes().empty());
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Empty trace
+
+    {
+        gray_trace_writer<std::uint16_t> writer;
+        gray_trace_reader<std::uint16_t> reader(writer);
+        std::uint16_t out[4];
+        assert(reader.read(out, 4) == 0);
+        reader.seek(0);
+        assert(reader.position() == 0);
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <cpp-gray/views.h>
+
+#if defined(__cpp_lib_ranges)
+////////////////////////////////////////////////////////////
+// Concepts
+
+static_assert(std::random_access_iterator<cppgray::gray_iterator<unsigned>>);
+static_assert(std::sized_sentinel_for<cppgray::gray_iterator<unsigned>,
+                                     cppgray::gray_iterator<unsigned>>);
+static_assert(std::ranges::view<cppgray::gray_view<unsigned>>);
+static_assert(std::ranges::random_access_range<cppgray::gray_view<unsigned>>);
+static_assert(std::ranges::sized_range<cppgray::gray_view<unsigned>>);
+static_assert(std::ranges::common_range<cppgray::gray_view<unsigned>>);
+static_assert(std::ranges::borrowed_range<cppgray::gray_view<unsigned>>);
+
+constexpr auto iterate(std::size_t bits)
+    -> bool
+{
+    using namespace cppgray;
+
+    std::uint64_t position = 0u;
+    for (auto code: views::gray<unsigned>(bits))
+    {
+        if (code != gray(static_cast<unsigned>(position++))) return false;
+    }
+    return position == (std::uint64_t(1) << bits);
+}
+
+constexpr auto random_access()
+    -> bool
+{
+    using namespace cppgray;
+
+    auto view = views::gray<unsigned>(10u);
+    auto it = view.begin();
+
+    it += 300;
+    if (*it != gray(300u) || it.position() != 300u) return false;
+    it -= 45;
+    if (*it != gray(255u)) return false;
+    if (it[17] != gray(272u) || it[-55] != gray(200u)) return false;
+    if ((it + 1).flipped_bit() != 8) return false;
+
+    --it;
+    if (*it != gray(254u) || it.flipped_bit() != 1) return false;
+
+    if (view.end() - it != 1024 - 254) return false;
+    if (not (it < view.end()) || it >= view.end()) return false;
+    if (view[700] != gray(700u) || view.back() != gray(1023u)) return false;
+    return view.begin() + 1024 == view.end() && view.size() == 1024u;
+}
+
+constexpr auto algorithms()
+    -> bool
+{
+    using namespace cppgray;
+
+    // Bisection over the positions, which only advances
+    // the iterators
+    auto view = views::gray<std::uint32_t>(28u);
+    auto it = std::ranges::partition_point(view, [](auto code) {
+        return static_cast<std::uint32_t>(code) < 123456789u;
+    });
+    if (it.position() != 123456789u || *it != gray(std::uint32_t(123456789u))) return false;
+
+    // The reversed view walks the Gray sequence backward
+    auto reversed = views::gray<unsigned>(4u) | std::views::reverse;
+    if (*reversed.begin() != gray(15u) || *std::ranges::next(reversed.begin(), 15) != gray(0u)) return false;
+
+    // Odd Gray codes are the ones at odd positions
+    auto odd = views::gray<unsigned>(5u, 21u)
+             | std::views::filter([](auto code) { return is_odd(code); });
+    unsigned position = 5u;
+    for (auto code: odd)
+    {
+        if (code != gray(position)) return false;
+        position += 2u;
+    }
+    return position == 21u && std::ranges::distance(odd) == 8;
+}
+
+template<typename Unsigned>
+constexpr auto full_width()
+    -> bool
+{
+    using namespace cppgray;
+
+    // The last code of a full-width view is reached by
+    // stepping back from its end
+    constexpr Unsigned max = std::numeric_limits<Unsigned>::max();
+    auto view = views::gray<Unsigned>(std::numeric_limits<Unsigned>::digits);
+    if (view.back() != gray(max)) return false;
+
+    auto reversed = view | std::views::reverse;
+    auto it = reversed.begin();
+    if (*it != gray(max) || *++it != gray(Unsigned(max - 1u))) return false;
+    return *std::ranges::next(reversed.begin(), 3) == gray(Unsigned(max - 3u));
+}
+
+int main()
+{
+    using namespace cppgray;
+
+    ////////////////////////////////////////////////////////////
+    // gray_view
+
+    {
+        static_assert(iterate(0u));
+        static_assert(iterate(1u));
+        static_assert(iterate(5u));
+        static_assert(random_access());
+        static_assert(algorithms());
+        static_assert(full_width<std::uint8_t>());
+        static_assert(full_width<std::uint32_t>());
+
+        static_assert(views::gray<unsigned char>(8u).size() == 256u);
+        static_assert(views::gray(3u, 3u).empty());
+        static_assert(gray_view<unsigned>().empty());
+        static_assert(views::gray(4u).begin().flipped_bit() == 64);
+        static_assert(views::gray(4u).front() == gray(std::uint64_t(0u)));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Conversion to gray_range
+
+    {
+        auto view = views::gray<unsigned>(37u, 80u);
+        auto range = view.range(10u);
+        assert(range.size() == view.size() && range.grain_size() == 10u);
+        assert(std::equal(range.begin(), range.end(), view.begin()));
+    }
+}
+#else
+int main()
+{
+    // Views are only available with the ranges of C++20
+}
+#endif
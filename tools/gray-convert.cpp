@@ -0,0 +1,372 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Converts a file of unsigned integers to Gray codes or the
+ * other way around.
+ *
+ *   gray-convert <encode|decode> <8|16|32|64> <le|be> <input> <output>
+ *
+ * The input file is made of unsigned integers of the given
+ * width in bits, stored in little-endian (le) or big-endian
+ * (be) order; the output file has the same format. Both
+ * files are memory-mapped and the conversion writes directly
+ * to the output mapping with the batch functions, without
+ * any intermediate buffer. When the byte order of the file
+ * differs from the native one, every chunk is byte-swapped
+ * while being copied to the output mapping, converted in
+ * place while still in cache, then swapped back. When the
+ * output is the input file itself, the file is converted in
+ * place through a single writable mapping.
+ *
+ * The tool only depends on POSIX:
+ *
+ *   g++ -std=c++14 -O2 -march=native -Iinclude tools/gray-convert.cpp -o gray-convert
+ */
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cpp-gray/batch.h>
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Memory-mapped files
+
+    class file_mapping
+    {
+        public:
+
+            file_mapping() = default;
+            file_mapping(const file_mapping&) = delete;
+            file_mapping& operator=(const file_mapping&) = delete;
+
+            ~file_mapping()
+            {
+                if (_data != nullptr)
+                {
+                    ::munmap(_data, _size);
+                }
+                if (_fd != -1)
+                {
+                    ::close(_fd);
+                }
+            }
+
+            // Maps a whole file for reading
+            auto open_input(const char* path)
+                -> bool
+            {
+                return open_existing(path, O_RDONLY, PROT_READ);
+            }
+
+            // Maps a whole file for reading and writing, without
+            // truncating it, to convert it in place
+            auto open_in_place(const char* path)
+                -> bool
+            {
+                return open_existing(path, O_RDWR, PROT_READ | PROT_WRITE);
+            }
+
+            // Whether a path names the mapped file
+            auto is_same_file(const char* path) const
+                -> bool
+            {
+                struct stat info;
+                return ::stat(path, &info) == 0 &&
+                       info.st_dev == _device && info.st_ino == _inode;
+            }
+
+            // Creates or truncates a file of the given size and
+            // maps it for writing
+            auto open_output(const char* path, std::size_t size)
+                -> bool
+            {
+                _fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (_fd == -1)
+                {
+                    return false;
+                }
+                if (::ftruncate(_fd, static_cast<off_t>(size)) == -1)
+                {
+                    return false;
+                }
+                _size = size;
+                return map(PROT_READ | PROT_WRITE, MADV_SEQUENTIAL);
+            }
+
+            auto data() const
+                -> void*
+            {
+                return _data;
+            }
+
+            auto size() const
+                -> std::size_t
+            {
+                return _size;
+            }
+
+        private:
+
+            auto open_existing(const char* path, int flags, int protection)
+                -> bool
+            {
+                _fd = ::open(path, flags);
+                if (_fd == -1)
+                {
+                    return false;
+                }
+                struct stat info;
+                if (::fstat(_fd, &info) == -1)
+                {
+                    return false;
+                }
+                _device = info.st_dev;
+                _inode = info.st_ino;
+                _size = static_cast<std::size_t>(info.st_size);
+                return map(protection, MADV_SEQUENTIAL);
+            }
+
+            auto map(int protection, int advice)
+                -> bool
+            {
+                if (_size == 0)
+                {
+                    // Empty files can't be mapped
+                    return true;
+                }
+                void* ptr = ::mmap(nullptr, _size, protection, MAP_SHARED, _fd, 0);
+                if (ptr == MAP_FAILED)
+                {
+                    return false;
+                }
+                _data = ptr;
+                ::madvise(_data, _size, advice);
+                return true;
+            }
+
+            int _fd = -1;
+            void* _data = nullptr;
+            std::size_t _size = 0;
+            dev_t _device = 0;
+            ino_t _inode = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Byte order
+
+    constexpr bool native_big_endian =
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+        __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+#else
+        false;
+#endif
+
+    inline auto byte_swap(std::uint8_t value)
+        -> std::uint8_t
+    {
+        return value;
+    }
+
+    inline auto byte_swap(std::uint16_t value)
+        -> std::uint16_t
+    {
+        return static_cast<std::uint16_t>((value << 8) | (value >> 8));
+    }
+
+    inline auto byte_swap(std::uint32_t value)
+        -> std::uint32_t
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap32(value);
+#else
+        return (value << 24) | ((value << 8) & 0x00ff0000u)
+             | ((value >> 8) & 0x0000ff00u) | (value >> 24);
+#endif
+    }
+
+    inline auto byte_swap(std::uint64_t value)
+        -> std::uint64_t
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(value);
+#else
+        return (std::uint64_t(byte_swap(static_cast<std::uint32_t>(value))) << 32)
+             | byte_swap(static_cast<std::uint32_t>(value >> 32));
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Conversion
+
+    // Number of bytes swapped and converted at once, small
+    // enough for the chunk to stay in the L1 cache
+    constexpr std::size_t chunk_bytes = 16 * 1024;
+
+    template<typename Unsigned>
+    auto convert_in_place(bool encode, Unsigned* data, std::size_t size)
+        -> void
+    {
+        auto codes = reinterpret_cast<cppgray::gray_code<Unsigned>*>(data);
+        if (encode)
+        {
+            cppgray::encode(data, codes, size);
+        }
+        else
+        {
+            cppgray::decode(codes, data, size);
+        }
+    }
+
+    template<typename Unsigned>
+    auto convert(bool encode, bool swap, const void* input, void* output, std::size_t bytes)
+        -> void
+    {
+        auto in = static_cast<const Unsigned*>(input);
+        auto out = static_cast<Unsigned*>(output);
+        std::size_t size = bytes / sizeof(Unsigned);
+
+        if (not swap)
+        {
+            if (encode)
+            {
+                cppgray::encode(in, reinterpret_cast<cppgray::gray_code<Unsigned>*>(out), size);
+            }
+            else
+            {
+                cppgray::decode(reinterpret_cast<const cppgray::gray_code<Unsigned>*>(in), out, size);
+            }
+            return;
+        }
+
+        constexpr std::size_t chunk_size = chunk_bytes / sizeof(Unsigned);
+        for (std::size_t start = 0 ; start < size ; start += chunk_size)
+        {
+            std::size_t count = size - start < chunk_size ? size - start : chunk_size;
+            for (std::size_t i = start ; i < start + count ; ++i)
+            {
+                out[i] = byte_swap(in[i]);
+            }
+            convert_in_place(encode, out + start, count);
+            for (std::size_t i = start ; i < start + count ; ++i)
+            {
+                out[i] = byte_swap(out[i]);
+            }
+        }
+    }
+
+    auto usage()
+        -> int
+    {
+        std::fprintf(stderr, "usage: gray-convert <encode|decode> <8|16|32|64> <le|be> <input> <output>\n");
+        return EXIT_FAILURE;
+    }
+
+    auto error(const char* what, const char* path)
+        -> int
+    {
+        std::fprintf(stderr, "gray-convert: %s %s: %s\n", what, path, std::strerror(errno));
+        return EXIT_FAILURE;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 6)
+    {
+        return usage();
+    }
+
+    const std::string operation = argv[1];
+    const std::string width = argv[2];
+    const std::string order = argv[3];
+    if ((operation != "encode" && operation != "decode") ||
+        (order != "le" && order != "be"))
+    {
+        return usage();
+    }
+    const bool encode = operation == "encode";
+    const bool swap = (order == "be") != native_big_endian;
+
+    std::size_t element_size = 0;
+    for (std::size_t size: { 1u, 2u, 4u, 8u })
+    {
+        if (width == std::to_string(size * 8))
+        {
+            element_size = size;
+        }
+    }
+    if (element_size == 0)
+    {
+        return usage();
+    }
+
+    file_mapping input;
+    if (not input.open_input(argv[4]))
+    {
+        return error("cannot map", argv[4]);
+    }
+    if (input.size() % element_size != 0)
+    {
+        std::fprintf(stderr, "gray-convert: the size of %s is not a multiple of %zu bytes\n",
+                     argv[4], element_size);
+        return EXIT_FAILURE;
+    }
+
+    // Truncating the input file would erase it before the
+    // conversion, so it is converted in place instead
+    file_mapping output;
+    const bool in_place = input.is_same_file(argv[5]);
+    if (in_place ? not output.open_in_place(argv[5])
+                 : not output.open_output(argv[5], input.size()))
+    {
+        return error("cannot map", argv[5]);
+    }
+    const void* source = in_place ? output.data() : input.data();
+
+    switch (element_size)
+    {
+        case 1:
+            convert<std::uint8_t>(encode, swap, source, output.data(), output.size());
+            break;
+        case 2:
+            convert<std::uint16_t>(encode, swap, source, output.data(), output.size());
+            break;
+        case 4:
+            convert<std::uint32_t>(encode, swap, source, output.data(), output.size());
+            break;
+        default:
+            convert<std::uint64_t>(encode, swap, source, output.data(), output.size());
+            break;
+    }
+}